@@ -0,0 +1,112 @@
+#include <algorithm>
+#include "Barrett.h"
+#include "PowWindows.h"
+
+namespace algo::math {
+
+namespace {
+
+// r[0..n+m) = a[0..n) * b[0..m) for operands in any order
+void mulAny(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limbs::Workspace &workspace) {
+    if (n < m) {
+        std::swap(a, b);
+        std::swap(n, m);
+    }
+    limbs::mul(r, a, n, b, m, workspace.alloc<limb_t>(limbs::mulScratchSize(n, m)));
+}
+
+// Columns from `from` upward of a[0..n) * b[0..m) into r[0..n+m), lower columns are left at zero
+// and their carries are lost, so r / b^from may come out too small by at most n
+void mulHigh(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, size_t from) {
+    std::fill(r, r + n + m, 0);
+    for (size_t i = 0; i < n; i++) {
+        const size_t j = (from > i ? from - i : 0);
+        if (j < m)
+            r[i + m] = limbs::addmul_1(r + i + j, b + j, m - j, a[i]);
+    }
+}
+
+// r[0..len) = a[0..n) * b[0..m) mod b^len
+void mulLow(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, size_t len) {
+    std::fill(r, r + len, 0);
+    for (size_t i = 0; i < n && i < len; i++) {
+        const size_t row = std::min(m, len - i);
+        const limb_t carry = limbs::addmul_1(r + i, b, row, a[i]);
+        if (i + row < len)
+            r[i + row] = carry;
+    }
+}
+
+}
+
+BarrettContext::BarrettContext(const BigUint &mod) : _mod(mod), _k(mod.data.size()) {
+    if (mod.isZero())
+        throw exception();
+    _mu.set_bit(2 * BigUint::limb_bits * _k);
+    _mu /= _mod;
+}
+
+void BarrettContext::reduce(BigUint &x) const {
+    const size_t n = x.data.size(), k = _k;
+    if (x < _mod)
+        return;
+    if (n > 2 * k) {
+        x %= _mod;
+        return;
+    }
+
+    limbs::Workspace workspace;
+    // q = floor(floor(x / b^(k-1)) * mu / b^(k+1)) is the quotient or at most 2 below it,
+    // one more with half products
+    const size_t q1n = n - (k - 1), mun = _mu.data.size();
+    // small moduli compute only the columns that matter, larger ones use fast multiplication
+    const bool half_products = k < kBarrettHalfProductLimbs;
+    limb_t *q2 = workspace.alloc<limb_t>(q1n + mun);
+    if (half_products)
+        mulHigh(q2, x.data.data() + (k - 1), q1n, _mu.data.data(), mun, k - 1);
+    else
+        mulAny(q2, x.data.data() + (k - 1), q1n, _mu.data.data(), mun, workspace);
+    const limb_t *q = q2 + (k + 1);
+    size_t qn = (q1n + mun > k + 1 ? q1n + mun - (k + 1) : 0);
+    while (qn > 0 && q[qn - 1] == 0)
+        qn--;
+
+    if (qn > 0) {
+        // the remainder estimate x - q * m is below 4m < b^(k+1), so only the low k + 1 limbs are computed
+        qn = std::min(qn, k + 1);
+        limb_t *p = workspace.alloc<limb_t>(qn + k);
+        if (half_products)
+            mulLow(p, q, qn, _mod.data.data(), k, k + 1);
+        else
+            mulAny(p, q, qn, _mod.data.data(), k, workspace);
+        x.data.resize(k + 1, 0);
+        limbs::subFrom(x.data.data(), k + 1, p, std::min(k + 1, qn + k));
+        x.removeZeros();
+    }
+    while (x >= _mod)
+        x -= _mod;
+}
+
+void BarrettContext::mul(BigUint &r, const BigUint &a, const BigUint &b) const {
+    r.multiply(a, b);
+    reduce(r);
+}
+
+void BarrettContext::sqr(BigUint &r, const BigUint &a) const {
+    r.square(a);
+    reduce(r);
+}
+
+BigUint BarrettContext::pow(const BigUint &base, const BigUint &power) const {
+    BigUint x = base;
+    reduce(x);
+    return slidingWindowPow(*this, x, power, BigUint(1) % _mod);
+}
+
+BigUint BarrettContext::powFixedWindow(const BigUint &base, const BigUint &power, size_t bits) const {
+    BigUint x = base;
+    reduce(x);
+    return fixedWindowPow(*this, x, power, BigUint(1) % _mod, bits);
+}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <BigInt/BigUint.h>
+#include <BigInt/Limbs.h>
+
+namespace algo::math {
+
+// Moduli below this size (limbs) estimate the quotient with half products (the needed columns only),
+// larger ones with full products from limbs::mul, see BigIntBarrettBenchmark in ArithmeticTests
+constexpr size_t kBarrettHalfProductLimbs = 512;
+
+// Reduction modulo a fixed m of k limbs by Barrett's method (HAC 14.42): with mu = floor(b^2k / m) precomputed,
+// the quotient of x < b^2k is estimated from two multiplications, and a few subtractions of m fix the rest.
+// Works for any modulus, even ones included. Built once per modulus, afterwards it is only read.
+class BarrettContext {
+public:
+    // throws for a zero modulus, like division
+    explicit BarrettContext(const BigUint &mod);
+
+    const BigUint &mod() const { return _mod; }
+
+    // x = x mod m without division for x < b^2k (every product of two reduced numbers),
+    // larger x are divided
+    void reduce(BigUint &x) const;
+
+    // r = a * b mod m for a, b < m, r may be a or b
+    void mul(BigUint &r, const BigUint &a, const BigUint &b) const;
+
+    void sqr(BigUint &r, const BigUint &a) const;
+
+    // base^power mod m with sliding windows
+    BigUint pow(const BigUint &base, const BigUint &power) const;
+
+    // base^power mod m with fixed windows over `bits` >= power.bit_length() exponent bits, see fixedWindowPow
+    BigUint powFixedWindow(const BigUint &base, const BigUint &power, size_t bits) const;
+
+private:
+    BigUint _mod;
+    size_t _k;
+    BigUint _mu;
+};
+
+}
@@ -6,6 +6,7 @@
 #include <set>
 #include <map>
 #include <Algorithms/BigIntMath.h>
+#include <Algorithms/PowWindows.h>
 
 namespace algo::math{
 
@@ -14,10 +15,12 @@ BigInt sqrt(BigInt num) {
     if (num == 0) return BigInt(0);
 
     BigInt curr = BigInt(1), next;
-    curr <<= (num.len() + 1 / 2);// TODO: FIX
+    curr <<= (num.bit_length() + 1) / 2; // 2^ceil(bits/2) > sqrt(num)
     int k = 0;
     while (true) {
-        next = (curr + num / curr) / 2;
+        next = num / curr;
+        next += curr;
+        next >>= 1;
         if (next >= curr) {
             return curr;
         }
@@ -27,53 +30,41 @@ BigInt sqrt(BigInt num) {
 
 BigInt pow(BigInt base, BigInt power) {
     BigInt res = 1;
-    while (power > 0) {
-        if (power % 2 == 1) {
-            res = res * base;
+    if (power <= 0)
+        return res;
+    for (size_t i = power.bit_length(); i-- > 0;) {
+        res *= res;
+        if (power.test_bit(i)) {
+            res *= base;
         }
-        base = base * base;
-        power = power / 2;
     }
     return res;
 }
 
 BigInt chineese(vector<pair<BigInt, BigInt>> nums) {
-    size_t n = nums.size();
-
-    vector<vector<BigInt>> rev(n, vector<BigInt>(n, BigInt(0)));
-    for (int i = 0; i < n; i++) {
-        for (int j = i + 1; j < n; j++) {
-            rev[i][j] = inverseMod(nums[i].second, nums[j].second);
-        }
-    }
-    vector<BigInt> x(n);
-    BigInt ans;
-    BigInt coef = 1;
-    for (int i = 0; i < n; i++) {
-        x[i] = nums[i].first;
-        for (int j = 0; j < i; j++) {
-            x[i] = rev[j][i] * (x[i] - x[j]);
-            x[i] = normMod(x[i], nums[i].second);
-        }
+    vector<BigInt> residues, moduli;
+    for (auto &[residue, modulus] : nums) {
+        residues.push_back(std::move(residue));
+        moduli.push_back(std::move(modulus));
     }
-    for (int i = 0; i < n; i++) {
-        ans = ans + x[i] * coef;
-        coef = coef * nums[i].second;
-    }
-    ans = normMod(ans, coef);
-    return ans;
+    return CrtBasis(moduli).reconstruct(residues);
 }
 
 BigInt gcdex(BigInt a, BigInt b, BigInt &x, BigInt &y) {
-    if (a == 0) {
-        x = 0;
-        y = 1;
-        return b;
+    BigInt d;
+    if (b.isZero()) {
+        d.mag = std::move(a.mag);
+        x = (a.sign < 0 ? -1 : 1);
+        y = 0;
+        return d;
     }
-    BigInt x1, y1, d;
-    d = gcdex(b % a, a, x1, y1);
-    x = y1 - (b / a) * x1;
-    y = x1;
+    d.mag = lehmerGcdex(a.mag, b.mag, x);
+    // |a| x = d (mod |b|), the cofactor of b is exact
+    if (a.sign < 0)
+        x.negate();
+    y = d;
+    y -= a * x;
+    y /= b;
     return d;
 }
 
@@ -109,29 +100,23 @@ BigInt abs(BigInt num) {
 }
 
 int Jacobi_symbol(BigInt a, BigInt b) {
-    if (a <= 0 || b % 2 == 0) return 0;
+    if (b <= 0 || !b.test_bit(0)) return 0;
+    // (a / b) only depends on a mod b, afterwards both stay non-negative
+    BigUint x = normMod(std::move(a), b).mag, y = std::move(b.mag);
     int ans = 1;
-    if (a < 0) {
-        a = -a;
-        if (b % 4 == 3) {
-            ans *= -1;
-        }
+    while (!x.isZero()) {
+        const size_t zeros = x.countr_zero();
+        x >>= zeros;
+        // (2 / y) = -1 for y = 3, 5 (mod 8)
+        if (zeros % 2 == 1 && ((y.data[0] & 7) == 3 || (y.data[0] & 7) == 5))
+            ans = -ans;
+        // quadratic reciprocity for odd x, y
+        if ((x.data[0] & 3) == 3 && (y.data[0] & 3) == 3)
+            ans = -ans;
+        std::swap(x, y);
+        x %= y;
     }
-    do {
-        do {
-            a = a / 2;
-            if (abs(b % 8 - 4) == 1)
-                ans *= -1;
-        } while (a % 2 == 0);
-
-        std::swap(a, b);
-        if (a % 4 == 3 && b % 4 == 3) ans *= -1;
-        a = a % b;
-    } while (a != 0);
-    if (b == 1)
-        return ans;
-    else
-        return 0;
+    return y == 1 ? ans : 0;
 }
 
 int legendre_symbol(BigInt a, BigInt p) {
@@ -150,6 +135,7 @@ BigInt pollardRhoIteration(BigInt num, BigInt step) {
     BigInt div = 1, one = 1;
     BigInt x_fixed = 1,  x = 2;
     int cycle = 2, count = 0;
+    BarrettContext reducer(num.mag);
     std::cerr << "Pollard Rho iteration: ";
     while (gcd(abs(x - x_fixed), num) == BigInt::ONE) {
         if(count == cycle){
@@ -157,7 +143,9 @@ BigInt pollardRhoIteration(BigInt num, BigInt step) {
             cycle *= 2;
             std::cerr << cycle  << " ";
         }
-        x = normMod(x*x + step, num);
+        x *= x;
+        x += step;
+        x = normMod(std::move(x), reducer);
         count++;
     }
     std::cerr << std::endl;
@@ -202,25 +190,15 @@ bool isPrimeFermat(BigInt num, int num_rounds) {
 }
 
 bool isPrimeMillerRabin(BigInt num, int num_rounds){
-    int r = 0;
-    BigInt d = num;
-    while(d % 2 == 0){
-        d = d / 2;
-        r++;
-    }
-    vector<int> primes = getFirstKprimes(num_rounds);
-    for(auto witness:primes){
-        if(witness + 2 > num) break;
-        BigInt x = powMod(witness, num-1, num);
-        if(x == 1 || x == num - 1)
-            continue;
-
-        for(int i = 1; i < r; i++){
-            x = mulMod(x,x,num);
-            if(x + 1 == num)
-                continue;
-        }
+    if(num < 4)
+        return num > 1;
+    if(!num.test_bit(0))
         return false;
+    MontgomeryContext context(num.mag);
+    for(auto witness : getFirstKprimes(num_rounds)){
+        if(witness + 1 >= num) break;
+        if(!isStrongProbablePrime(context, witness))
+            return false;
     }
     return true;
 }
@@ -235,7 +213,7 @@ std::map<BigInt, int> factorize(BigInt num, bool dummy) {
             if (num % prime_num == 0) {
                 int cnt = 0;
                 while (num % prime_num == 0) {
-                    num = num / prime_num;
+                    num /= prime_num;
                     cnt++;
                 }
                 ans[prime_num] = ans[prime_num] + cnt;
@@ -257,43 +235,163 @@ std::map<BigInt, int> factorize(BigInt num, bool dummy) {
 }
 
 bool isPrime(BigInt num) {
-    int num_rounds = num.len() + 3;
-    if(num.len() <= 4) return isPrimeDummy(num);
-    if(!isPrimeDummy(num, num_rounds)) return false;
-    if(!isPrimeMillerRabin(num, num_rounds)) return false;
-    return true;
+    return num > 1 && isProbablePrime(num.mag);
 }
 
 
 BigInt gcd(BigInt a, BigInt b) {
-    while (a != BigInt::ZERO && b != BigInt::ZERO)
-        if(a >= b)
-            a %= b;
-        else
-            b %= a;
-    return a + b;
+    BigInt res;
+    res.mag = lehmerGcd(std::move(a.mag), std::move(b.mag));
+    return res;
 }
 
 BigInt inverseMod(BigInt num, BigInt mod) {
-    BigInt x, y, g;
-    g = gcdex(num, mod, x, y);
-    if(g != 1){
-        throw;
+    num = normMod(std::move(num), mod);
+    BigInt x;
+    if (lehmerGcdex(std::move(num.mag), mod.mag, x) != 1)
+        throw std::invalid_argument("number is not invertible modulo mod");
+    return normMod(std::move(x), std::move(mod));
+}
+
+static BigInt residueToBigInt(BigUint x) {
+    BigInt res;
+    res.mag = std::move(x);
+    return res;
+}
+
+static BigUint inverseResidue(const BigUint &x, const BigInt &mod) {
+    return inverseMod(residueToBigInt(x), mod).mag;
+}
+
+void batchInverseMod(std::span<BigInt> nums, const BigInt &mod) {
+    if(mod <= 0)
+        throw std::invalid_argument("modulus must be positive");
+    const size_t n = nums.size();
+    if(n == 0)
+        return;
+    BarrettContext reducer(mod.mag);
+    std::vector<BigUint> residues(n);
+    for(size_t i = 0; i < n; i++)
+        residues[i] = normMod(nums[i], reducer).mag;
+
+    if(n >= kBatchInverseParallelMinTerms && limbs::canStartParallel()){
+        // level l + 1 holds the products of pairs from level l, an odd last element moves up alone
+        std::vector<std::vector<BigUint>> tree{std::move(residues)};
+        while(tree.back().size() > 1){
+            const std::vector<BigUint> &level = tree.back();
+            std::vector<BigUint> next((level.size() + 1) / 2);
+            #pragma omp parallel for schedule(dynamic, 16)
+            for(size_t j = 0; j < next.size(); j++){
+                if(2 * j + 1 < level.size())
+                    reducer.mul(next[j], level[2 * j], level[2 * j + 1]);
+                else
+                    next[j] = level[2 * j];
+            }
+            tree.push_back(std::move(next));
+        }
+        // going down, the inverse of a node is the inverse of its parent times its sibling
+        std::vector<BigUint> inverses{inverseResidue(tree.back()[0], mod)};
+        for(size_t l = tree.size() - 1; l-- > 0;){
+            const std::vector<BigUint> &level = tree[l];
+            std::vector<BigUint> next(level.size());
+            #pragma omp parallel for schedule(dynamic, 16)
+            for(size_t j = 0; j < level.size(); j++){
+                if((j ^ 1) < level.size())
+                    reducer.mul(next[j], inverses[j / 2], level[j ^ 1]);
+                else
+                    next[j] = inverses[j / 2];
+            }
+            inverses = std::move(next);
+        }
+        for(size_t i = 0; i < n; i++)
+            nums[i] = residueToBigInt(std::move(inverses[i]));
+        return;
     }
-    return normMod(x, mod);
+
+    // prefix[i] = residues[0] * ... * residues[i]
+    std::vector<BigUint> prefix(n);
+    prefix[0] = residues[0];
+    for(size_t i = 1; i < n; i++)
+        reducer.mul(prefix[i], prefix[i - 1], residues[i]);
+    // inverse = prefix[i]^-1 at the start of step i, prefix[i] is replaced by residues[i]^-1
+    BigUint inverse = inverseResidue(prefix[n - 1], mod);
+    for(size_t i = n; i-- > 1;){
+        reducer.mul(prefix[i], inverse, prefix[i - 1]);
+        reducer.mul(inverse, inverse, residues[i]);
+    }
+    prefix[0] = std::move(inverse);
+    for(size_t i = 0; i < n; i++)
+        nums[i] = residueToBigInt(std::move(prefix[i]));
 }
 
 BigInt powMod(BigInt base, BigInt power, BigInt mod) {
     BigInt res = 1;
-    while(power > 0){
-        if(power % 2 == 1){
-            res = mulMod(res, base, mod);
-        }
-        base = mulMod(base, base, mod);
-        power = power / 2;
+    if(power <= 0)
+        return res;
+    if(mod > 0 && mod.test_bit(0) && mod.mag.data.size() < kMontgomeryMaxLimbs)
+        return powMod(std::move(base), power, MontgomeryContext(mod.mag));
+    return powMod(std::move(base), power, BarrettContext(mod.mag));
+}
+
+BigInt powMod(BigInt base, const BigInt &power, const MontgomeryContext &mod) {
+    BigInt res = 1;
+    if(power <= 0)
+        return res;
+    // toMontgomery reduces the magnitude, a negative base still needs its complement
+    base.mag %= mod.mod();
+    if(base.sign < 0 && !base.mag.isZero())
+        base.mag.subtractFrom(mod.mod());
+    res.mag = mod.pow(base.mag, power.mag);
+    return res;
+}
+
+BigInt powMod(BigInt base, const BigInt &power, const BarrettContext &mod) {
+    BigInt res = 1;
+    if(power <= 0)
+        return res;
+    res.mag = mod.pow(normMod(std::move(base), mod).mag, power.mag);
+    return res;
+}
+
+BigInt powModFixedWindow(BigInt base, BigInt power, BigInt mod) {
+    BigInt res = 1;
+    if(power <= 0)
+        return res;
+    // the window count follows the modulus, so all exponents below it take the same steps
+    const size_t bits = std::max(power.bit_length(), mod.bit_length());
+    if(mod > 0 && mod.test_bit(0) && mod.mag.data.size() < kMontgomeryMaxLimbs){
+        MontgomeryContext context(mod.mag);
+        res.mag = context.powFixedWindow(normMod(std::move(base), mod).mag, power.mag, bits);
+    }else{
+        BarrettContext context(mod.mag);
+        res.mag = context.powFixedWindow(normMod(std::move(base), context).mag, power.mag, bits);
+    }
+    return res;
+}
+BigInt multiPowMod(const std::vector<BigInt> &bases, const std::vector<BigInt> &powers, const BigInt &mod) {
+    if(bases.size() != powers.size())
+        throw std::invalid_argument("multiPowMod needs one power per base");
+    if(mod <= 0)
+        throw std::invalid_argument("modulus must be positive");
+    std::vector<BigUint> residues(bases.size()), exponents(powers.size());
+    for(size_t i = 0; i < bases.size(); i++){
+        residues[i] = normMod(bases[i], mod).mag;
+        if(powers[i] > 0)
+            exponents[i] = powers[i].mag;
+    }
+    BigInt res;
+    if(mod.test_bit(0) && mod.mag.data.size() < kMontgomeryMaxLimbs){
+        MontgomeryContext context(mod.mag);
+        for(auto &residue : residues)
+            residue = context.toMontgomery(residue);
+        res.mag = context.fromMontgomery(multiPow(context, residues, exponents, context.one()));
+    }else{
+        BarrettContext context(mod.mag);
+        res.mag = multiPow(context, residues, exponents, BigUint(1) % mod.mag);
     }
     return res;
 }
+
 BigInt logMod(BigInt base, BigInt ans, BigInt mod) {
     // Baby step giant step
 
@@ -302,58 +400,90 @@ BigInt logMod(BigInt base, BigInt ans, BigInt mod) {
     BigInt block_size = sqrt(mod) + 1;
     BigInt giant_step = powMod(base, block_size, mod);
 
+    BarrettContext reducer(mod.mag);
+
     // Giant step
     std::map<BigInt, BigInt> giant_steps;
     BigInt curr = giant_step;
-    for(BigInt i = 1; i <= block_size; i = i + 1){
+    for(BigInt i = 1; i <= block_size; i += 1){
         if(!giant_steps.count(curr))
             giant_steps[curr] = i;
-        curr = mulMod(curr, giant_step, mod);
+        curr *= giant_step;
+        curr = normMod(std::move(curr), reducer);
     }
 
     // Small step
-    curr = ans;
-    for(BigInt i = 0; i <= block_size; i = i + 1){
+    base = normMod(std::move(base), mod);
+    curr = normMod(std::move(ans), mod);
+    for(BigInt i = 0; i <= block_size; i += 1){
         if(giant_steps.count(curr)){
-            BigInt res = giant_steps[curr] * block_size - i;
+            BigInt res = giant_steps[curr] * block_size;
+            res -= i;
             if(res < mod)
                 return res;
         }
-        curr = mulMod(curr, base, mod);
+        curr *= base;
+        curr = normMod(std::move(curr), reducer);
     }
     return -1;
 }
 
 BigInt normMod(BigInt num, BigInt mod) {
     num %= mod;
-    if(num >= 0){
-        return num;
-    }else{
-        num = num + mod;
-        return num % mod;
+    if(num < 0){
+        num += mod;
+        num %= mod;
     }
+    return num;
 }
 
 BigInt addMod(BigInt lhs, BigInt rhs, BigInt mod) {
-    return normMod(normMod(lhs, mod) + normMod(rhs, mod), mod);
+    lhs += rhs;
+    return normMod(std::move(lhs), std::move(mod));
 }
 
 BigInt subMod(BigInt lhs, BigInt rhs, BigInt mod) {
-    return normMod(lhs - rhs, mod);
+    lhs -= rhs;
+    return normMod(std::move(lhs), std::move(mod));
 }
 
 BigInt mulMod(BigInt lhs, BigInt rhs, BigInt mod) {
-    return normMod(lhs * rhs, mod);
+    lhs *= rhs;
+    return normMod(std::move(lhs), std::move(mod));
 }
 
 BigInt divMod(BigInt lhs, BigInt rhs, BigInt mod) {
-    return normMod(normMod(lhs, mod) * inverseMod(normMod(rhs, mod), mod), mod);
+    lhs *= inverseMod(normMod(std::move(rhs), mod), mod);
+    return normMod(std::move(lhs), std::move(mod));
+}
+
+BigInt normMod(BigInt num, const BarrettContext &mod) {
+    mod.reduce(num.mag);
+    if(num.sign < 0 && !num.mag.isZero())
+        num.mag.subtractFrom(mod.mod());
+    num.setSign(1);
+    return num;
+}
+
+BigInt addMod(BigInt lhs, const BigInt &rhs, const BarrettContext &mod) {
+    lhs += rhs;
+    return normMod(std::move(lhs), mod);
+}
+
+BigInt subMod(BigInt lhs, const BigInt &rhs, const BarrettContext &mod) {
+    lhs -= rhs;
+    return normMod(std::move(lhs), mod);
+}
+
+BigInt mulMod(BigInt lhs, const BigInt &rhs, const BarrettContext &mod) {
+    lhs *= rhs;
+    return normMod(std::move(lhs), mod);
 }
 
 BigInt euler(BigInt num) {
     std::map<BigInt, int> f = factorize(num);
     for(auto it:f){
-        num = num - num / it.first;
+        num -= num / it.first;
     }
     return num;
 }
@@ -370,7 +500,7 @@ int mobius(BigInt num) {
 
 BigInt GenNextPrime(BigInt num) {
     for(int i = 0; i < 10000; i++) {
-        num = num + BigInt{1};
+        num += 1;
         if(isPrime(num)) {
             return num;
         }
@@ -1,14 +1,48 @@
 #pragma once
 
 #include <map>
+#include <span>
 #include <BigInt/BigInt.h>
+#include <BigInt/FixedUint.h>
+#include <Algorithms/Barrett.h>
+#include <Algorithms/Crt.h>
+#include <Algorithms/FixedBasePowMod.h>
+#include <Algorithms/Gcd.h>
+#include <Algorithms/Montgomery.h>
+#include <Algorithms/Primality.h>
 
 namespace algo::math{
 
+// num^-1 mod m in [0, m), throws std::invalid_argument if gcd(num, m) != 1
 BigInt inverseMod(BigInt num, BigInt mod);
 
+// Batches from this size are inverted through a product tree whose levels are multiplied in parallel
+constexpr size_t kBatchInverseParallelMinTerms = 256;
+
+// Replaces every nums[i] by its inverse modulo m in [0, m) with one inverseMod and 3(n - 1) multiplications
+// (Montgomery's trick): the product of all numbers is inverted, and the single inverses come from it and
+// the partial products. Throws std::invalid_argument if mod <= 0 or some number is not invertible,
+// nums is unchanged then.
+void batchInverseMod(std::span<BigInt> nums, const BigInt &mod);
+
+// Sliding windows, odd moduli go through a MontgomeryContext and others through a BarrettContext,
+// so the loop does no divisions
 BigInt powMod(BigInt base, BigInt power, BigInt mod);
 
+// Sliding-window powMod with a context built by the caller, for many exponentiations modulo one number
+BigInt powMod(BigInt base, const BigInt &power, const MontgomeryContext &mod);
+
+BigInt powMod(BigInt base, const BigInt &power, const BarrettContext &mod);
+
+// Fixed windows over max(bits of power, bits of mod) exponent bits, so the sequence of squarings and
+// multiplications does not depend on a (secret) exponent below mod, see fixedWindowPow
+BigInt powModFixedWindow(BigInt base, BigInt power, BigInt mod);
+
+// prod bases[i]^powers[i] mod m with one shared chain of squarings: Straus' interleaved windows for a few terms,
+// Pippenger's buckets for many. Non-positive powers contribute 1 as in powMod. Throws std::invalid_argument
+// if the sizes differ or mod <= 0.
+BigInt multiPowMod(const std::vector<BigInt> &bases, const std::vector<BigInt> &powers, const BigInt &mod);
+
 BigInt normMod(BigInt num, BigInt mod);
 
 BigInt addMod(BigInt lhs, BigInt rhs, BigInt mod);
@@ -19,14 +53,28 @@ BigInt mulMod(BigInt lhs, BigInt rhs, BigInt mod);
 
 BigInt divMod(BigInt lhs, BigInt rhs, BigInt mod);
 
+// Versions for a modulus that is used again and again, reduction by a BarrettContext costs two
+// multiplications instead of a division. The modulus must be positive.
+BigInt normMod(BigInt num, const BarrettContext &mod);
+
+BigInt addMod(BigInt lhs, const BigInt &rhs, const BarrettContext &mod);
+
+BigInt subMod(BigInt lhs, const BigInt &rhs, const BarrettContext &mod);
+
+BigInt mulMod(BigInt lhs, const BigInt &rhs, const BarrettContext &mod);
+
 BigInt sqrt(BigInt num);
 
 BigInt pow(BigInt base, BigInt power);
 
+// x in [0, prod m_i) with x = a_i (mod m_i) for the pairs (a_i, m_i), by a CrtBasis. Build the basis
+// directly to reconstruct many times over the same moduli.
 BigInt chineese(vector<pair<BigInt, BigInt>> nums);
 
+// non-negative, by lehmerGcd
 BigInt gcd(BigInt a, BigInt b);
 
+// d = gcd(a, b) >= 0 and a * x + b * y = d, iterative (lehmerGcdex)
 BigInt gcdex(BigInt a, BigInt b, BigInt &x, BigInt &y);
 
 void sieve(int num, std::vector<int> &primes, std::vector<int> &least_prime);
@@ -37,8 +85,11 @@ BigInt abs(BigInt num);
 
 int legendre_symbol(BigInt a, BigInt p);
 
+// (a / b) for odd b > 0 and any a, 0 for other b
 int Jacobi_symbol(BigInt a, BigInt b);
 
+// Baillie-PSW: trial division by the small primes, a strong test to base 2 and a strong Lucas test,
+// see isProbablePrime
 bool isPrime(BigInt num);
 
 BigInt GenNextPrime(BigInt num);
@@ -47,6 +98,7 @@ bool isPrimeDummy(BigInt num, int num_primes = -1);
 
 bool isPrimeFermat(BigInt num, int num_rounds);
 
+// strong probable prime tests to the first num_rounds primes as bases
 bool isPrimeMillerRabin(BigInt num, int num_rounds);
 
 BigInt _pollardRhoNextNum(BigInt num);
@@ -58,4 +110,44 @@ std::map<BigInt, int> factorize(BigInt num, bool dummy = true);
 BigInt euler(BigInt num);
 
 int mobius(BigInt num);
+
+// Fixed-width versions for EC fields and RSA moduli, operands must already be reduced modulo mod.
+// addMod and subMod do not branch on the values.
+
+template<size_t Bits>
+FixedUint<Bits> addMod(const FixedUint<Bits> &lhs, const FixedUint<Bits> &rhs, const FixedUint<Bits> &mod) {
+    FixedUint<Bits> sum, reduced;
+    const limb_t carry = FixedUint<Bits>::add(sum, lhs, rhs);
+    const limb_t borrow = FixedUint<Bits>::sub(reduced, sum, mod);
+    return FixedUint<Bits>::select(carry | (borrow ^ 1), reduced, sum);
+}
+
+template<size_t Bits>
+FixedUint<Bits> subMod(const FixedUint<Bits> &lhs, const FixedUint<Bits> &rhs, const FixedUint<Bits> &mod) {
+    FixedUint<Bits> diff, wrapped;
+    const limb_t borrow = FixedUint<Bits>::sub(diff, lhs, rhs);
+    FixedUint<Bits>::add(wrapped, diff, mod);
+    return FixedUint<Bits>::select(borrow, wrapped, diff);
+}
+
+template<size_t Bits>
+FixedUint<Bits> mulMod(const FixedUint<Bits> &lhs, const FixedUint<Bits> &rhs, const FixedUint<Bits> &mod) {
+    return FixedUint<Bits>::reduce(lhs.mulWide(rhs), mod);
+}
+
+template<size_t Bits, size_t PowerBits>
+FixedUint<Bits> powMod(const FixedUint<Bits> &base, const FixedUint<PowerBits> &power, const FixedUint<Bits> &mod) {
+    FixedUint<Bits> res = FixedUint<Bits>::reduce(FixedUint<Bits>(1), mod);
+    for (size_t i = power.bit_length(); i-- > 0;) {
+        res = mulMod(res, res, mod);
+        if (power.test_bit(i))
+            res = mulMod(res, base, mod);
+    }
+    return res;
+}
+
+template<size_t Bits>
+FixedUint<Bits> inverseMod(const FixedUint<Bits> &num, const FixedUint<Bits> &mod) {
+    return FixedUint<Bits>(inverseMod(num.toBigInt(), mod.toBigInt()));
+}
 }
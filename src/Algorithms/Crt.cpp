@@ -0,0 +1,110 @@
+#include <BigInt/Limbs.h>
+#include "Crt.h"
+#include "Gcd.h"
+
+namespace algo::math {
+
+CrtBasis::CrtBasis(const std::vector<BigInt> &moduli) {
+    const size_t n = moduli.size();
+    std::vector<BigUint> leaves(n);
+    for (size_t i = 0; i < n; i++) {
+        if (moduli[i] <= 0)
+            throw std::invalid_argument("CRT moduli must be positive");
+        leaves[i] = moduli[i].mag;
+    }
+    _parallel = (n >= kCrtParallelMinModuli && limbs::canStartParallel());
+    _tree.push_back(std::move(leaves));
+    if (n == 0)
+        _tree.push_back({BigUint(1)});
+    while (_tree.back().size() > 1) {
+        const std::vector<BigUint> &level = _tree.back();
+        std::vector<BigUint> next((level.size() + 1) / 2);
+        // the top levels have few but large nodes, their products parallelize by themselves
+        #pragma omp parallel for schedule(dynamic) if(_parallel && next.size() > 1)
+        for (size_t j = 0; j < next.size(); j++) {
+            if (2 * j + 1 < level.size())
+                next[j].multiply(level[2 * j], level[2 * j + 1]);
+            else
+                next[j] = level[2 * j];
+        }
+        _tree.push_back(std::move(next));
+    }
+
+    // remainders of M modulo the squares of the nodes, going down
+    std::vector<BigUint> rems{product()};
+    for (size_t l = _tree.size() - 1; l-- > 0;) {
+        const std::vector<BigUint> &level = _tree[l];
+        std::vector<BigUint> next(level.size());
+        #pragma omp parallel for schedule(dynamic) if(_parallel && next.size() > 1)
+        for (size_t j = 0; j < level.size(); j++) {
+            BigUint square;
+            square.square(level[j]);
+            next[j] = rems[j / 2];
+            if (next[j] >= square)
+                next[j] %= square;
+        }
+        rems = std::move(next);
+    }
+
+    // M mod m_i^2 = m_i ((M / m_i) mod m_i)
+    _inverses.resize(n);
+    bool coprime = true;
+    #pragma omp parallel for schedule(dynamic) if(_parallel)
+    for (size_t i = 0; i < n; i++) {
+        const BigUint &m = _tree[0][i];
+        rems[i] /= m;
+        BigInt x;
+        if (lehmerGcdex(rems[i], m, x) != 1) {
+            #pragma omp atomic write
+            coprime = false;
+            continue;
+        }
+        if (x.sign < 0)
+            x.mag.subtractFrom(m);
+        _inverses[i] = std::move(x.mag);
+    }
+    if (!coprime)
+        throw std::invalid_argument("CRT moduli must be pairwise coprime");
+}
+
+BigInt CrtBasis::reconstruct(const std::vector<BigInt> &residues) const {
+    const size_t n = size();
+    if (residues.size() != n)
+        throw std::invalid_argument("CRT needs one residue per modulus");
+    BigInt res;
+    if (n == 0)
+        return res;
+
+    // a_i s_i mod m_i at the leaves, a node holds sum a_i s_i P / m_i over its leaves for its product P
+    std::vector<BigUint> values(n);
+    #pragma omp parallel for schedule(dynamic) if(_parallel)
+    for (size_t i = 0; i < n; i++) {
+        const BigUint &m = _tree[0][i];
+        BigUint a = residues[i].mag % m;
+        if (residues[i].sign < 0 && !a.isZero())
+            a.subtractFrom(m);
+        values[i].multiply(a, _inverses[i]);
+        values[i] %= m;
+    }
+    for (size_t l = 0; l + 1 < _tree.size(); l++) {
+        const std::vector<BigUint> &level = _tree[l];
+        std::vector<BigUint> next(_tree[l + 1].size());
+        #pragma omp parallel for schedule(dynamic) if(_parallel && next.size() > 1)
+        for (size_t j = 0; j < next.size(); j++) {
+            if (2 * j + 1 < level.size()) {
+                BigUint t;
+                next[j].multiply(values[2 * j], level[2 * j + 1]);
+                t.multiply(values[2 * j + 1], level[2 * j]);
+                next[j] += t;
+            } else {
+                next[j] = std::move(values[2 * j]);
+            }
+        }
+        values = std::move(next);
+    }
+    res.mag = std::move(values[0]);
+    res.mag %= product();
+    return res;
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <BigInt/BigInt.h>
+
+namespace algo::math {
+
+// Bases from this many moduli evaluate the nodes of one tree level in parallel
+constexpr size_t kCrtParallelMinModuli = 64;
+
+// Chinese remaindering over fixed pairwise coprime moduli m_i with M = prod m_i (Bernstein's
+// "scaled remainder tree" form). The constructor builds the product tree and, going down a remainder
+// tree of M mod m_i^2, the constants s_i = (M / m_i)^-1 mod m_i: n inversions in total.
+// A reconstruction sums a_i s_i M / m_i bottom-up over the product tree, so with fast multiplication both
+// take quasi-linear time. Built once, afterwards it is only read, so one basis can be shared between threads.
+class CrtBasis {
+public:
+    // throws std::invalid_argument if a modulus is not positive or two of them have a common factor
+    explicit CrtBasis(const std::vector<BigInt> &moduli);
+
+    // M, 1 for no moduli
+    const BigUint &product() const { return _tree.back()[0]; }
+
+    size_t size() const { return _inverses.size(); }
+
+    // the x in [0, M) with x = residues[i] (mod m_i), residues may be negative or unreduced.
+    // Throws std::invalid_argument if the number of residues differs from the number of moduli.
+    BigInt reconstruct(const std::vector<BigInt> &residues) const;
+
+private:
+    // level 0 holds the moduli, level l + 1 the products of pairs from level l (an odd last node moves up
+    // alone), the last level the single product M
+    std::vector<std::vector<BigUint>> _tree;
+    std::vector<BigUint> _inverses; // s_i
+    bool _parallel;
+};
+
+}
@@ -6,10 +6,16 @@
 #define BIGINT_PROJECT_ELIPTICCURVE_H
 
 #include <BigInt/BigInt.h>
+#include <Algorithms/Barrett.h>
 
 class ElipticCurve {
 public:
+    ElipticCurve(const BigInt &a, const BigInt &b, const BigInt &p) : a(a), b(b), p(p), reducer(p.mag) {}
+
     BigInt a, b, p;
+
+    // reduces modulo p in point arithmetic, built from p once per curve
+    algo::math::BarrettContext reducer;
 };
 
 
@@ -22,13 +22,24 @@ ElipticCurveNumber operator+(const ElipticCurveNumber &a, const ElipticCurveNumb
     if (b.x.isZero() && b.y.isZero()) {
         return a;
     }
-    BigInt slope = (
-            a == b ?
-            (3 * a.x * a.x + a.curve.a) * algo::math::inverseMod(2 * a.y, a.curve.p) % a.curve.p :
-            (a.y + a.curve.p - b.y) * algo::math::inverseMod(a.x + a.curve.p - b.x, a.curve.p) % a.curve.p
-    );
-    c.x = (slope * slope + ((2 * a.curve.p - a.x) - b.x)) % a.curve.p;
-    c.y = (slope * (a.x + a.curve.p - c.x) + a.curve.p - a.y) % a.curve.p;
+    // every product has factors below p, so the reductions need no division
+    const algo::math::BarrettContext &mod = a.curve.reducer;
+    BigInt slope;
+    if (a == b) {
+        slope = algo::math::mulMod(a.x, a.x, mod);
+        slope *= 3;
+        slope = algo::math::addMod(std::move(slope), a.curve.a, mod);
+        slope = algo::math::mulMod(std::move(slope), algo::math::inverseMod(2 * a.y, a.curve.p), mod);
+    } else {
+        slope = algo::math::subMod(a.y, b.y, mod);
+        slope = algo::math::mulMod(std::move(slope), algo::math::inverseMod(a.x + a.curve.p - b.x, a.curve.p), mod);
+    }
+    c.x = algo::math::mulMod(slope, slope, mod);
+    c.x = algo::math::subMod(std::move(c.x), a.x, mod);
+    c.x = algo::math::subMod(std::move(c.x), b.x, mod);
+    c.y = algo::math::subMod(a.x, c.x, mod);
+    c.y = algo::math::mulMod(std::move(c.y), slope, mod);
+    c.y = algo::math::subMod(std::move(c.y), a.y, mod);
     return c;
 }
 
@@ -63,18 +74,17 @@ ElipticCurveNumber operator*(const ElipticCurveNumber &a, BigInt b) {
     }
     ElipticCurveNumber c(a.curve);
     ElipticCurveNumber A = a;
-    while(!b.isZero()) {
-        if (b % 2 == 1) {
+    for (size_t i = 0, bits = b.bit_length(); i < bits; i++) {
+        if (b.test_bit(i)) {
             c = (c+A);
         }
         A = (A+A);
-        b = b / 2;
     }
     return c;
 }
 
 ElipticCurveNumber ElipticCurveNumber::inverse() const {
-    return ElipticCurveNumber(curve, x, (curve.p-y)%curve.p);
+    return ElipticCurveNumber(curve, x, algo::math::subMod(curve.p, y, curve.reducer));
 }
 
 bool operator<(const ElipticCurveNumber &a, const ElipticCurveNumber &b) {
@@ -0,0 +1,71 @@
+#include "FixedBasePowMod.h"
+#include "BigIntMath.h"
+
+namespace algo::math {
+
+FixedBasePowMod::FixedBasePowMod(const BigInt &base, const BigInt &mod, size_t max_power_bits, size_t window_bits)
+        : _mod(mod.mag), _window_bits(std::max<size_t>(window_bits, 1)),
+          _windows((std::max<size_t>(max_power_bits, 1) + _window_bits - 1) / _window_bits) {
+    if (mod <= 0)
+        throw std::invalid_argument("modulus must be positive");
+    _base = normMod(base, mod).mag;
+    if (_mod.test_bit(0) && _mod.data.size() < kMontgomeryMaxLimbs) {
+        _montgomery.emplace(_mod);
+        build(*_montgomery, _montgomery->toMontgomery(_base));
+    } else {
+        _barrett.emplace(_mod);
+        build(*_barrett, _base);
+    }
+}
+
+template<typename Context>
+void FixedBasePowMod::build(const Context &context, BigUint x) {
+    const size_t digits = (size_t(1) << _window_bits) - 1;
+    _table.resize(_windows * digits);
+    // x = base^(2^(w i)) at the start of window i
+    for (size_t i = 0; i < _windows; i++) {
+        BigUint *entries = _table.data() + i * digits;
+        entries[0] = x;
+        for (size_t d = 1; d < digits; d++)
+            context.mul(entries[d], entries[d - 1], x);
+        context.mul(x, entries[digits - 1], x);
+    }
+}
+
+template<typename Context>
+BigUint FixedBasePowMod::evaluate(const Context &context, const BigUint &power) const {
+    const size_t digits = (size_t(1) << _window_bits) - 1;
+    BigUint res;
+    bool started = false;
+    for (size_t i = 0; i < _windows; i++) {
+        size_t d = 0;
+        for (size_t t = (i + 1) * _window_bits; t-- > i * _window_bits;)
+            d = 2 * d + power.test_bit(t);
+        if (d == 0)
+            continue;
+        const BigUint &entry = _table[i * digits + d - 1];
+        if (started) {
+            context.mul(res, res, entry);
+        } else {
+            res = entry;
+            started = true;
+        }
+    }
+    return res;
+}
+
+BigInt FixedBasePowMod::operator()(const BigInt &power) const {
+    BigInt res = 1;
+    if (power <= 0)
+        return res;
+    if (power.bit_length() > _windows * _window_bits) {
+        res.mag = (_montgomery ? _montgomery->pow(_base, power.mag) : _barrett->pow(_base, power.mag));
+        return res;
+    }
+    // power > 0, so some window is non-zero and the result comes from the table
+    res.mag = (_montgomery ? _montgomery->fromMontgomery(evaluate(*_montgomery, power.mag))
+                           : evaluate(*_barrett, power.mag));
+    return res;
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+#include <BigInt/BigInt.h>
+#include <Algorithms/Barrett.h>
+#include <Algorithms/Montgomery.h>
+
+namespace algo::math {
+
+// base^power mod m for one base and modulus and many exponents (key agreement with a fixed generator).
+// The table holds base^(d * 2^(w i)) for every w-bit window i of the exponent and digit d, so an exponentiation
+// multiplies one entry per non-zero window: about bits / w multiplications and no squarings.
+// The table takes max_power_bits / w * (2^w - 1) residues. Evaluation only reads it, so one object
+// can be shared between threads.
+class FixedBasePowMod {
+public:
+    static constexpr size_t kDefaultWindowBits = 4;
+
+    // base is reduced modulo mod (m > 0), exponents up to max_power_bits bits use the table
+    FixedBasePowMod(const BigInt &base, const BigInt &mod, size_t max_power_bits,
+                    size_t window_bits = kDefaultWindowBits);
+
+    // base^power mod m, 1 for power <= 0 as in powMod. Longer exponents than the table covers
+    // fall back to sliding windows.
+    BigInt operator()(const BigInt &power) const;
+
+    const BigUint &mod() const { return _mod; }
+
+private:
+    template<typename Context>
+    void build(const Context &context, BigUint x);
+
+    // power > 0 of at most _windows * _window_bits bits, result in the context's form
+    template<typename Context>
+    BigUint evaluate(const Context &context, const BigUint &power) const;
+
+    BigUint _mod, _base;
+    size_t _window_bits, _windows;
+    // Montgomery for odd moduli, Barrett otherwise
+    std::optional<MontgomeryContext> _montgomery;
+    std::optional<BarrettContext> _barrett;
+    // entry i * (2^w - 1) + d - 1 is base^(d * 2^(w i)), in Montgomery form with a Montgomery context
+    std::vector<BigUint> _table;
+};
+
+}
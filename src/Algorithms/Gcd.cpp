@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <bit>
+#include <BigInt/Limbs.h>
+#include "Gcd.h"
+
+namespace algo::math {
+
+namespace {
+
+size_t countrZero(limb_ll x) {
+    const limb_t low = limb_t(x);
+    return low ? std::countr_zero(low) : BigUint::limb_bits + std::countr_zero(limb_t(x >> BigUint::limb_bits));
+}
+
+// Stein's binary gcd: shifts and subtractions only
+limb_ll binaryGcd(limb_ll u, limb_ll v) {
+    if (u == 0 || v == 0)
+        return u | v;
+    const size_t shift = countrZero(u | v);
+    u >>= countrZero(u);
+    do {
+        v >>= countrZero(v);
+        if (u > v)
+            std::swap(u, v);
+        v -= u;
+    } while (v != 0);
+    return u << shift;
+}
+
+limb_ll toWords(const BigUint &x) {
+    return x.data.size() > 1 ? limb_ll(x.data[1]) << BigUint::limb_bits | x.data[0] : limb_ll(x.data[0]);
+}
+
+BigUint fromWords(limb_ll x) {
+    BigUint res = limb_t(x);
+    if (x >> BigUint::limb_bits)
+        res.data.push_back(limb_t(x >> BigUint::limb_bits));
+    return res;
+}
+
+// bits [shift, shift + 63) of x
+int64_t leadingBits(const BigUint &x, size_t shift) {
+    const size_t i = shift / BigUint::limb_bits, offset = shift % BigUint::limb_bits;
+    if (i >= x.data.size())
+        return 0;
+    limb_ll words = x.data[i];
+    if (i + 1 < x.data.size())
+        words |= limb_ll(x.data[i + 1]) << BigUint::limb_bits;
+    return int64_t(limb_t(words >> offset) & (limb_t(-1) >> 1));
+}
+
+// Euclid steps for u >= v > 0 decided by their leading bits. The steps taken so far map (u, v)
+// to (A u + B v, C u + D v); the entries alternate in sign and D > 0 after an even number of steps.
+// Returns false if not even the first quotient is certain, then the caller divides.
+struct LehmerMatrix {
+    int64_t a = 1, b = 0, c = 0, d = 1;
+
+    bool simulate(const BigUint &u, const BigUint &v) {
+        const size_t bits = u.bit_length(), shift = (bits > 63 ? bits - 63 : 0);
+        __int128 uh = leadingBits(u, shift), vh = leadingBits(v, shift);
+        // (uh + a) / (vh + c) and (uh + b) / (vh + d) bound the true quotient, a step is taken
+        // only if both agree
+        while (true) {
+            const __int128 n1 = uh + a, d1 = vh + c, n2 = uh + b, d2 = vh + d;
+            if (d1 <= 0 || d2 <= 0 || n1 < 0 || n2 < 0)
+                break;
+            const __int128 q = n1 / d1;
+            if (q != n2 / d2)
+                break;
+            __int128 t = a - q * c;
+            a = c;
+            c = int64_t(t);
+            t = b - q * d;
+            b = d;
+            d = int64_t(t);
+            t = uh - q * vh;
+            uh = vh;
+            vh = t;
+        }
+        return b != 0;
+    }
+};
+
+limb_t magnitude(int64_t x) {
+    return x < 0 ? limb_t(0) - limb_t(x) : limb_t(x);
+}
+
+// r = a x - b y, which must not be negative
+void mulSub(BigUint &r, const BigUint &x, limb_t a, const BigUint &y, limb_t b) {
+    const size_t n = std::max(x.data.size(), y.data.size()) + 1;
+    r.data.assign(n, 0);
+    limbs::addMulTo(r.data.data(), n, x.data.data(), x.data.size(), a);
+    limbs::subMulFrom(r.data.data(), n, y.data.data(), y.data.size(), b);
+    r.removeZeros();
+}
+
+// r = a x + b y
+void mulAdd(BigUint &r, const BigUint &x, limb_t a, const BigUint &y, limb_t b) {
+    const size_t n = std::max(x.data.size(), y.data.size()) + 2;
+    r.data.assign(n, 0);
+    limbs::addMulTo(r.data.data(), n, x.data.data(), x.data.size(), a);
+    limbs::addMulTo(r.data.data(), n, y.data.data(), y.data.size(), b);
+    r.removeZeros();
+}
+
+// (u, v) = (A u + B v, C u + D v), the signs of the entries are known from the parity of D
+void apply(const LehmerMatrix &m, BigUint &u, BigUint &v, BigUint &t0, BigUint &t1) {
+    const limb_t a = magnitude(m.a), b = magnitude(m.b), c = magnitude(m.c), d = magnitude(m.d);
+    if (m.d > 0) {
+        mulSub(t0, u, a, v, b);
+        mulSub(t1, v, d, u, c);
+    } else {
+        mulSub(t0, v, b, u, a);
+        mulSub(t1, u, c, v, d);
+    }
+    std::swap(u, t0);
+    std::swap(v, t1);
+}
+
+}
+
+BigUint lehmerGcd(BigUint a, BigUint b) {
+    if (a < b)
+        std::swap(a, b);
+    BigUint t0, t1;
+    while (!b.isZero()) {
+        if (a.data.size() <= kBinaryGcdMaxLimbs)
+            return fromWords(binaryGcd(toWords(a), toWords(b)));
+        LehmerMatrix m;
+        if (m.simulate(a, b)) {
+            apply(m, a, b, t0, t1);
+        } else {
+            a %= b;
+            std::swap(a, b);
+        }
+    }
+    return a;
+}
+
+BigUint lehmerGcdex(BigUint a, BigUint b, BigInt &x) {
+    // u_i = a x_i (mod b) with x_i of sign (-1)^i, only the magnitudes are kept
+    BigUint x0 = 1, x1 = 0, t0, t1, q;
+    bool odd = false;
+    if (a < b) {
+        std::swap(a, b);
+        std::swap(x0, x1);
+        odd = true;
+    }
+    while (!b.isZero()) {
+        LehmerMatrix m;
+        if (m.simulate(a, b)) {
+            apply(m, a, b, t0, t1);
+            const limb_t ma = magnitude(m.a), mb = magnitude(m.b), mc = magnitude(m.c), md = magnitude(m.d);
+            mulAdd(t0, x0, ma, x1, mb);
+            mulAdd(t1, x0, mc, x1, md);
+            std::swap(x0, t0);
+            std::swap(x1, t1);
+            odd ^= (m.d < 0);
+        } else {
+            a.divModInPlace(b, &q);
+            std::swap(a, b);
+            // x_(i+2) = x_i - q x_(i+1), the signs differ, so the magnitudes add
+            q *= x1;
+            x0 += q;
+            std::swap(x0, x1);
+            odd = !odd;
+        }
+    }
+    x = 0;
+    x.mag = std::move(x0);
+    if (odd && !x.mag.isZero())
+        x.negate();
+    return a;
+}
+
+}
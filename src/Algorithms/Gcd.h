@@ -0,0 +1,19 @@
+#pragma once
+
+#include <BigInt/BigInt.h>
+
+namespace algo::math {
+
+// Numbers up to this size (limbs) finish with binary gcd on 128-bit words
+constexpr size_t kBinaryGcdMaxLimbs = 2;
+
+// gcd(a, b) by Lehmer's method (Knuth 4.5.2, Algorithm L): Euclid is simulated on the leading 63 bits
+// in single words, and the collected quotients are applied to the full numbers as one 2x2 matrix,
+// so a pass over the limbs removes about a word instead of one quotient
+BigUint lehmerGcd(BigUint a, BigUint b);
+
+// g = gcd(a, b) and x with a * x = g (mod b), |x| <= b / g, without recursion. The cofactor of b follows
+// from y = (g - a * x) / b, inverses modulo b need only x.
+BigUint lehmerGcdex(BigUint a, BigUint b, BigInt &x);
+
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include "Montgomery.h"
+#include "PowWindows.h"
+
+namespace algo::math {
+
+MontgomeryContext::MontgomeryContext(const BigUint &mod) : _mod(mod), _k(mod.data.size()) {
+    if (!mod.test_bit(0))
+        throw std::invalid_argument("Montgomery modulus must be odd");
+
+    // Newton iteration for n0^-1 mod 2^64, every step doubles the number of correct low bits
+    // (an odd n0 is its own inverse mod 8)
+    const limb_t n0 = mod.data[0];
+    limb_t inv = n0;
+    for (int i = 0; i < 5; i++)
+        inv *= 2 - n0 * inv;
+    _inv = limb_t(0) - inv;
+
+    _r2.set_bit(2 * BigUint::limb_bits * _k);
+    _r2 %= _mod;
+    _one = fromMontgomery(_r2);
+}
+
+BigUint MontgomeryContext::toMontgomery(const BigUint &x) const {
+    BigUint res = x;
+    if (res >= _mod)
+        res %= _mod;
+    mul(res, res, _r2);
+    return res;
+}
+
+BigUint MontgomeryContext::fromMontgomery(const BigUint &x) const {
+    limbs::Workspace workspace;
+    limb_t *t = workspace.alloc<limb_t>(2 * _k);
+    std::copy(x.data.begin(), x.data.end(), t);
+    std::fill(t + x.data.size(), t + 2 * _k, 0);
+    BigUint res;
+    reduce(res, t);
+    return res;
+}
+
+void MontgomeryContext::mul(BigUint &r, const BigUint &a, const BigUint &b) const {
+    if (&a == &b) {
+        sqr(r, a);
+        return;
+    }
+    const BigUint &x = (a.data.size() >= b.data.size() ? a : b);
+    const BigUint &y = (a.data.size() >= b.data.size() ? b : a);
+    const size_t n = x.data.size(), m = y.data.size();
+    limbs::Workspace workspace;
+    limb_t *t = workspace.alloc<limb_t>(2 * _k);
+    limb_t *scratch = workspace.alloc<limb_t>(limbs::mulScratchSize(n, m));
+    limbs::mul(t, x.data.data(), n, y.data.data(), m, scratch);
+    std::fill(t + n + m, t + 2 * _k, 0);
+    reduce(r, t);
+}
+
+void MontgomeryContext::sqr(BigUint &r, const BigUint &a) const {
+    const size_t n = a.data.size();
+    limbs::Workspace workspace;
+    limb_t *t = workspace.alloc<limb_t>(2 * _k);
+    limb_t *scratch = workspace.alloc<limb_t>(limbs::mulScratchSize(n, n));
+    limbs::sqr(t, a.data.data(), n, scratch);
+    std::fill(t + 2 * n, t + 2 * _k, 0);
+    reduce(r, t);
+}
+
+void MontgomeryContext::reduce(BigUint &r, limb_t *t) const {
+    const limb_t *n = _mod.data.data();
+    // each pass clears t[i] by adding a multiple of n, the carry out of t[i + k] moves up with the next pass
+    limb_t top = 0;
+    for (size_t i = 0; i < _k; i++) {
+        const limb_t carry = limbs::addmul_1(t + i, n, _k, t[i] * _inv);
+        const limb_ll sum = limb_ll(t[i + _k]) + carry + top;
+        t[i + _k] = limb_t(sum);
+        top = limb_t(sum >> BigUint::limb_bits);
+    }
+    // the result is below 2n
+    limb_t *res = t + _k;
+    if (top || limbs::compare(res, _k, n, _k) >= 0)
+        limbs::sub_n(res, res, n, _k);
+    r.data.resize(_k);
+    std::copy(res, res + _k, r.data.begin());
+    r.removeZeros();
+}
+
+BigUint MontgomeryContext::pow(const BigUint &base, const BigUint &power) const {
+    return fromMontgomery(slidingWindowPow(*this, toMontgomery(base), power, _one));
+}
+
+BigUint MontgomeryContext::powFixedWindow(const BigUint &base, const BigUint &power, size_t bits) const {
+    return fromMontgomery(fixedWindowPow(*this, toMontgomery(base), power, _one, bits));
+}
+
+}
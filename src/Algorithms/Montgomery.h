@@ -0,0 +1,54 @@
+#pragma once
+
+#include <BigInt/BigUint.h>
+#include <BigInt/Limbs.h>
+
+namespace algo::math {
+
+// Moduli from this size (limbs) are left to division based reduction, whose Newton path
+// grows like a multiplication while word-by-word REDC stays quadratic
+constexpr size_t kMontgomeryMaxLimbs = limbs::kDivNewtonThreshold;
+
+// Arithmetic modulo a fixed odd n on numbers in Montgomery form x * R mod n, R = 2^(64 k) for a k-limb n.
+// A product is reduced by REDC, k multiply-add passes over n, instead of a long division.
+// Built once per modulus, afterwards it is only read, so one context can be shared between threads.
+class MontgomeryContext {
+public:
+    // throws std::invalid_argument for an even (or zero) modulus
+    explicit MontgomeryContext(const BigUint &mod);
+
+    const BigUint &mod() const { return _mod; }
+
+    // R mod n, the Montgomery form of 1
+    const BigUint &one() const { return _one; }
+
+    // x * R mod n, x may be of any size
+    BigUint toMontgomery(const BigUint &x) const;
+
+    // x * R^-1 mod n, x < n
+    BigUint fromMontgomery(const BigUint &x) const;
+
+    // r = a * b * R^-1 mod n for a, b < n, r may be a or b
+    void mul(BigUint &r, const BigUint &a, const BigUint &b) const;
+
+    // r = a * a * R^-1 mod n
+    void sqr(BigUint &r, const BigUint &a) const;
+
+    // base^power mod n with sliding windows, base and result in normal form
+    BigUint pow(const BigUint &base, const BigUint &power) const;
+
+    // base^power mod n with fixed windows over `bits` >= power.bit_length() exponent bits, see fixedWindowPow
+    BigUint powFixedWindow(const BigUint &base, const BigUint &power, size_t bits) const;
+
+private:
+    // t[0..2k) holds a product < n * R, writes t * R^-1 mod n to r
+    void reduce(BigUint &r, limb_t *t) const;
+
+    BigUint _mod;
+    size_t _k;
+    limb_t _inv; // -n^-1 mod 2^64
+    BigUint _r2; // R^2 mod n
+    BigUint _one;
+};
+
+}
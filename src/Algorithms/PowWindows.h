@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <BigInt/BigUint.h>
+
+// Windowed exponentiation shared by the reduction contexts. A Context provides mul(r, a, b) and sqr(r, a)
+// on numbers in its own representation (Montgomery form or plain residues), r may be an operand.
+namespace algo::math {
+
+constexpr size_t kMaxPowWindowBits = 6;
+
+// Window width that minimizes squarings plus table and window multiplications for an exponent of `bits` bits
+constexpr size_t powWindowBits(size_t bits) {
+    return bits <= 8 ? 1 : bits <= 24 ? 2 : bits <= 80 ? 3 : bits <= 240 ? 4 : bits <= 672 ? 5 : kMaxPowWindowBits;
+}
+
+// out[i] = base^(2i + 1) for i < 2^(w - 1)
+template<typename Context>
+void oddPowers(const Context &context, const BigUint &base, size_t w, BigUint *out) {
+    out[0] = base;
+    if (w > 1) {
+        BigUint square;
+        context.sqr(square, base);
+        for (size_t i = 1; i < (size_t(1) << (w - 1)); i++)
+            context.mul(out[i], out[i - 1], square);
+    }
+}
+
+// the `bits` bits of power from bit `low` upward
+inline size_t windowValue(const BigUint &power, size_t low, size_t bits) {
+    size_t value = 0;
+    for (size_t t = low + bits; t-- > low;)
+        value = 2 * value + power.test_bit(t);
+    return value;
+}
+
+// base^power with sliding windows over the odd powers base, base^3, ..., base^(2^w - 1).
+// Zero bits between windows cost only a squaring.
+template<typename Context>
+BigUint slidingWindowPow(const Context &context, const BigUint &base, const BigUint &power, const BigUint &one) {
+    const size_t bits = power.bit_length();
+    if (bits == 0)
+        return one;
+    const size_t w = powWindowBits(bits);
+    std::array<BigUint, size_t(1) << (kMaxPowWindowBits - 1)> odd_powers;
+    oddPowers(context, base, w, odd_powers.data());
+
+    BigUint res;
+    bool started = false;
+    for (size_t i = bits; i > 0;) {
+        if (!power.test_bit(i - 1)) {
+            context.sqr(res, res);
+            i--;
+            continue;
+        }
+        // longest window [j, i) of at most w bits that ends in a set bit
+        size_t j = (i > w ? i - w : 0);
+        while (!power.test_bit(j))
+            j++;
+        const size_t value = windowValue(power, j, i - j);
+        if (started) {
+            for (size_t t = j; t < i; t++)
+                context.sqr(res, res);
+            context.mul(res, res, odd_powers[value >> 1]);
+        } else {
+            res = odd_powers[value >> 1];
+            started = true;
+        }
+        i = j;
+    }
+    return res;
+}
+
+// base^power with fixed windows of w bits over the low `bits` bits of power (bits >= power.bit_length()).
+// Every exponent of that length takes the same squarings and multiplications, a zero window multiplies by one.
+// The table is still indexed by the window value and BigUint skips leading zero limbs,
+// so this evens out the operation count but is not constant time at the machine level.
+template<typename Context>
+BigUint fixedWindowPow(const Context &context, const BigUint &base, const BigUint &power, const BigUint &one,
+                       size_t bits) {
+    const size_t w = powWindowBits(bits);
+    std::array<BigUint, size_t(1) << kMaxPowWindowBits> powers;
+    powers[0] = one;
+    for (size_t i = 1; i < (size_t(1) << w); i++)
+        context.mul(powers[i], powers[i - 1], base);
+
+    BigUint res = one;
+    for (size_t i = (bits + w - 1) / w * w; i > 0; i -= w) {
+        size_t value = 0;
+        for (size_t t = i; t-- > i - w;) {
+            context.sqr(res, res);
+            value = 2 * value + power.test_bit(t);
+        }
+        context.mul(res, res, powers[value]);
+    }
+    return res;
+}
+
+// Product of bases[j]^powers[j] by Straus' interleaving: each exponent is cut into its own sliding windows,
+// and all of them share one chain of squarings, so k exponentiations cost about one plus their window multiplications
+template<typename Context>
+BigUint strausPow(const Context &context, const std::vector<BigUint> &bases, const std::vector<BigUint> &powers,
+                  const BigUint &one) {
+    struct Window {
+        size_t low, index;
+    };
+    const size_t k = bases.size();
+    std::vector<std::vector<BigUint>> odd_powers(k);
+    std::vector<std::vector<Window>> windows(k);
+    size_t bits = 0;
+    for (size_t j = 0; j < k; j++) {
+        const BigUint &power = powers[j];
+        const size_t n = power.bit_length();
+        if (n == 0)
+            continue;
+        bits = std::max(bits, n);
+        const size_t w = powWindowBits(n);
+        odd_powers[j].resize(size_t(1) << (w - 1));
+        oddPowers(context, bases[j], w, odd_powers[j].data());
+        // windows from the top, as in slidingWindowPow
+        for (size_t i = n; i > 0;) {
+            if (!power.test_bit(i - 1)) {
+                i--;
+                continue;
+            }
+            size_t low = (i > w ? i - w : 0);
+            while (!power.test_bit(low))
+                low++;
+            windows[j].push_back({low, windowValue(power, low, i - low) >> 1});
+            i = low;
+        }
+    }
+
+    std::vector<size_t> next(k, 0);
+    BigUint res;
+    bool started = false;
+    for (size_t pos = bits; pos-- > 0;) {
+        if (started)
+            context.sqr(res, res);
+        for (size_t j = 0; j < k; j++) {
+            if (next[j] == windows[j].size() || windows[j][next[j]].low != pos)
+                continue;
+            const BigUint &entry = odd_powers[j][windows[j][next[j]++].index];
+            if (started) {
+                context.mul(res, res, entry);
+            } else {
+                res = entry;
+                started = true;
+            }
+        }
+    }
+    return started ? res : one;
+}
+
+// Multiplications of Pippenger's method with c-bit windows for k exponents of `bits` bits
+constexpr size_t pippengerCost(size_t k, size_t bits, size_t c) {
+    return (bits + c - 1) / c * (k + (size_t(2) << c));
+}
+
+constexpr size_t pippengerWindowBits(size_t k, size_t bits) {
+    size_t c = 1;
+    for (size_t t = 2; t < 20; t++)
+        if (pippengerCost(k, bits, t) < pippengerCost(k, bits, c))
+            c = t;
+    return c;
+}
+
+// Product of bases[j]^powers[j] by Pippenger's bucket method: for every c-bit window the bases are multiplied
+// into the bucket of their digit, and prod B[d]^d comes from two running products over the buckets.
+// A window costs k + 2^(c+1) multiplications whatever the digits, c is picked from k and the exponent length.
+template<typename Context>
+BigUint pippengerPow(const Context &context, const std::vector<BigUint> &bases, const std::vector<BigUint> &powers,
+                     const BigUint &one) {
+    const size_t k = bases.size();
+    size_t bits = 0;
+    for (const BigUint &power : powers)
+        bits = std::max(bits, power.bit_length());
+    if (bits == 0)
+        return one;
+    const size_t c = pippengerWindowBits(k, bits);
+
+    std::vector<BigUint> buckets(size_t(1) << c);
+    std::vector<char> filled(size_t(1) << c);
+    BigUint res, acc, sum;
+    bool started = false;
+    for (size_t window = (bits + c - 1) / c; window-- > 0;) {
+        if (started)
+            for (size_t t = 0; t < c; t++)
+                context.sqr(res, res);
+        std::fill(filled.begin(), filled.end(), 0);
+        for (size_t j = 0; j < k; j++) {
+            const size_t d = windowValue(powers[j], window * c, c);
+            if (d == 0)
+                continue;
+            if (filled[d]) {
+                context.mul(buckets[d], buckets[d], bases[j]);
+            } else {
+                buckets[d] = bases[j];
+                filled[d] = 1;
+            }
+        }
+        // acc = prod over e >= d of B[e], sum = prod of acc over d = prod B[d]^d
+        bool acc_set = false, sum_set = false;
+        for (size_t d = buckets.size(); d-- > 1;) {
+            if (filled[d]) {
+                if (acc_set) {
+                    context.mul(acc, acc, buckets[d]);
+                } else {
+                    acc = buckets[d];
+                    acc_set = true;
+                }
+            }
+            if (!acc_set)
+                continue;
+            if (sum_set) {
+                context.mul(sum, sum, acc);
+            } else {
+                sum = acc;
+                sum_set = true;
+            }
+        }
+        if (!sum_set)
+            continue;
+        if (started) {
+            context.mul(res, res, sum);
+        } else {
+            res = sum;
+            started = true;
+        }
+    }
+    return started ? res : one;
+}
+
+// strausPow or pippengerPow, whichever needs fewer multiplications, bases in the context's form.
+// Straus pays a table and about n / (w + 1) window products per exponent, so buckets win only
+// for hundreds of terms, see BigIntMultiPowBenchmark in ArithmeticTests.
+template<typename Context>
+BigUint multiPow(const Context &context, const std::vector<BigUint> &bases, const std::vector<BigUint> &powers,
+                 const BigUint &one) {
+    size_t bits = 0, straus = 0;
+    for (const BigUint &power : powers) {
+        const size_t n = power.bit_length(), w = powWindowBits(n);
+        bits = std::max(bits, n);
+        straus += n / (w + 1) + (size_t(1) << (w - 1));
+    }
+    if (straus <= pippengerCost(bases.size(), bits, pippengerWindowBits(bases.size(), bits)))
+        return strausPow(context, bases, powers, one);
+    return pippengerPow(context, bases, powers, one);
+}
+
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <numeric>
+#include "Primality.h"
+#include "BigIntMath.h"
+#include "PowWindows.h"
+
+namespace algo::math {
+
+namespace {
+
+struct SmallPrimes {
+    std::vector<int> primes;
+    // products of consecutive odd primes, each as large as fits in a word
+    std::vector<limb_t> products;
+};
+
+const SmallPrimes &smallPrimes() {
+    static const SmallPrimes table = [] {
+        SmallPrimes res;
+        std::vector<int> least_prime;
+        sieve(int(kTrialDivisionBound) - 1, res.primes, least_prime);
+        limb_t product = 1;
+        for (size_t i = 1; i < res.primes.size(); i++) {
+            const limb_t p = limb_t(res.primes[i]);
+            if (product > limb_t(-1) / p) {
+                res.products.push_back(product);
+                product = 1;
+            }
+            product *= p;
+        }
+        res.products.push_back(product);
+        return res;
+    }();
+    return table;
+}
+
+// v mod n in [0, n)
+BigUint residue(int64_t v, const BigUint &n) {
+    BigUint res = BigUint::magnitude(v);
+    res %= n;
+    if (v < 0 && !res.isZero())
+        res.subtractFrom(n);
+    return res;
+}
+
+// x = x + y mod n, x = x - y mod n and x = x / 2 mod n for x, y < n
+void addResidue(BigUint &x, const BigUint &y, const BigUint &n) {
+    x += y;
+    if (x >= n)
+        x -= n;
+}
+
+void subResidue(BigUint &x, const BigUint &y, const BigUint &n) {
+    if (x < y)
+        x += n;
+    x -= y;
+}
+
+void halveResidue(BigUint &x, const BigUint &n) {
+    if (x.test_bit(0))
+        x += n;
+    x >>= 1;
+}
+
+}
+
+bool hasSmallFactor(const BigUint &n) {
+    if (!n.test_bit(0))
+        return true;
+    for (limb_t product : smallPrimes().products)
+        if (std::gcd(n.modWord(product), product) != 1)
+            return true;
+    return false;
+}
+
+bool isStrongProbablePrime(const MontgomeryContext &context, const BigUint &base) {
+    const BigUint &n = context.mod();
+    BigUint d = n;
+    d.subWord(1);
+    const size_t r = d.countr_zero();
+    d >>= r;
+    // -1 in Montgomery form
+    BigUint minus_one = n;
+    minus_one -= context.one();
+
+    BigUint x = slidingWindowPow(context, context.toMontgomery(base), d, context.one());
+    if (x == context.one() || x == minus_one)
+        return true;
+    for (size_t i = 1; i < r; i++) {
+        context.sqr(x, x);
+        if (x == minus_one)
+            return true;
+        // a square root of 1 other than +-1
+        if (x == context.one())
+            return false;
+    }
+    return false;
+}
+
+bool isStrongLucasProbablePrime(const MontgomeryContext &context) {
+    const BigUint &n = context.mod();
+    BigInt modulus;
+    modulus.mag = n;
+    int64_t d = 5;
+    while (true) {
+        // no D is found for a square, test for one once a few candidates failed
+        if (d == 13) {
+            const BigInt root = sqrt(modulus);
+            if (root * root == modulus)
+                return false;
+        }
+        const int jacobi = Jacobi_symbol(d, modulus);
+        if (jacobi == -1)
+            break;
+        if (jacobi == 0 && n != BigUint::magnitude(d))
+            return false;
+        d = (d > 0 ? -d - 2 : -d + 2);
+    }
+    const int64_t q = (1 - d) / 4;
+
+    // n + 1 = k 2^s
+    BigUint k = n;
+    k.addWord(1);
+    const size_t s = k.countr_zero();
+    k >>= s;
+    const BigUint d_form = context.toMontgomery(residue(d, n)), q_form = context.toMontgomery(residue(q, n));
+    // U_j, V_j and Q^j in Montgomery form for the leading bits j of k, starting from j = 1
+    BigUint u = context.one(), v = context.one(), qj = q_form, t;
+    for (size_t i = k.bit_length() - 1; i-- > 0;) {
+        // U_2j = U_j V_j, V_2j = V_j^2 - 2 Q^j
+        context.mul(u, u, v);
+        context.sqr(v, v);
+        subResidue(v, qj, n);
+        subResidue(v, qj, n);
+        context.sqr(qj, qj);
+        if (k.test_bit(i)) {
+            // U_(j+1) = (P U_j + V_j) / 2, V_(j+1) = (D U_j + P V_j) / 2 with P = 1
+            context.mul(t, d_form, u);
+            addResidue(t, v, n);
+            halveResidue(t, n);
+            addResidue(u, v, n);
+            halveResidue(u, n);
+            std::swap(v, t);
+            context.mul(qj, qj, q_form);
+        }
+    }
+    if (u.isZero() || v.isZero())
+        return true;
+    // V_(k 2^r) for r < s
+    for (size_t r = 1; r < s; r++) {
+        context.sqr(v, v);
+        subResidue(v, qj, n);
+        subResidue(v, qj, n);
+        if (v.isZero())
+            return true;
+        context.sqr(qj, qj);
+    }
+    return false;
+}
+
+bool isProbablePrime(const BigUint &n, size_t rounds, bool lucas) {
+    const SmallPrimes &table = smallPrimes();
+    if (n < kTrialDivisionBound)
+        return std::binary_search(table.primes.begin(), table.primes.end(), int(n.data[0]));
+    if (hasSmallFactor(n))
+        return false;
+    if (n < kTrialDivisionBound * kTrialDivisionBound)
+        return true;
+    MontgomeryContext context(n);
+    for (size_t i = 0; i < std::min(rounds, table.primes.size()); i++)
+        if (!isStrongProbablePrime(context, table.primes[i]))
+            return false;
+    return !lucas || isStrongLucasProbablePrime(context);
+}
+
+}
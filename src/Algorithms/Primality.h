@@ -0,0 +1,30 @@
+#pragma once
+
+#include <BigInt/BigUint.h>
+#include <Algorithms/Montgomery.h>
+
+namespace algo::math {
+
+// Prime factors below this bound are found by trial division before any exponentiation
+constexpr limb_t kTrialDivisionBound = 1000;
+
+// True if n >= kTrialDivisionBound has a prime factor below the bound. The primorial is kept in word-sized
+// pieces, so this costs one remainder pass over n and one word gcd per piece, without a BigUint division.
+bool hasSmallFactor(const BigUint &n);
+
+// Strong probable prime test (Miller-Rabin) of the context's odd modulus n > 3 to one base:
+// with n - 1 = d 2^r, base^d = 1 or base^(d 2^i) = -1 for some i < r
+bool isStrongProbablePrime(const MontgomeryContext &context, const BigUint &base);
+
+// Strong Lucas probable prime test of the context's odd modulus n > 3 with Selfridge's parameters:
+// the first D in 5, -7, 9, -11, ... with Jacobi (D / n) = -1, P = 1 and Q = (1 - D) / 4.
+// Perfect squares, for which no such D exists, are composite.
+bool isStrongLucasProbablePrime(const MontgomeryContext &context);
+
+// Trial division by the primes below kTrialDivisionBound, then strong tests to the first `rounds` primes
+// as bases (at most all primes below the bound) and, if lucas is set, a strong Lucas test. Base 2 and
+// Lucas together are the Baillie-PSW test, which has no known pseudoprime. Numbers below the square of
+// the bound are decided by trial division alone.
+bool isProbablePrime(const BigUint &n, size_t rounds = 1, bool lucas = true);
+
+}
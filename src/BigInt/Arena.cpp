@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <bit>
+#include <new>
+#include "Arena.h"
+
+namespace limbs {
+
+namespace {
+
+constexpr size_t kMinClassBytes = 256;
+constexpr int kClasses = 20;                   // up to 128 MB, larger blocks go to the heap directly
+constexpr size_t kMaxCachedBytes = 16 << 20;   // per class and thread
+constexpr size_t kWorkspaceAlign = 64;
+constexpr size_t kFirstChunkBytes = 64 << 10;
+constexpr int kMaxChunks = 64;                 // chunk sizes at least double
+
+struct FreeBlock {
+    FreeBlock *next;
+};
+
+struct Chunk {
+    char *data;
+    size_t size;
+};
+
+// Trivially destructible, so it stays usable after Cleanup ran at thread exit
+// (static BigUints of the main thread are destroyed after its thread-local objects).
+struct State {
+    FreeBlock *free[kClasses];
+    size_t cached[kClasses];
+    Chunk chunks[kMaxChunks];
+    size_t chunk_count, current_chunk, offset;
+    size_t heap_allocations;
+    bool closed;
+};
+
+thread_local State state;
+
+struct Cleanup {
+    bool active = false;
+
+    ~Cleanup() {
+        for (int c = 0; c < kClasses; c++) {
+            while (state.free[c]) {
+                FreeBlock *block = state.free[c];
+                state.free[c] = block->next;
+                ::operator delete(block);
+            }
+        }
+        for (size_t i = 0; i < state.chunk_count; i++)
+            ::operator delete(state.chunks[i].data, std::align_val_t(kWorkspaceAlign));
+        state.chunk_count = 0;
+        state.closed = true;
+    }
+};
+
+thread_local Cleanup cleanup;
+
+// registers the thread exit cleanup on first use
+void touch() {
+    if (!state.closed)
+        cleanup.active = true;
+}
+
+int sizeClass(size_t bytes) {
+    return std::bit_width((std::max<size_t>(bytes, 1) - 1) / kMinClassBytes);
+}
+
+void *heapAllocate(size_t bytes) {
+    state.heap_allocations++;
+    return ::operator new(bytes);
+}
+
+}
+
+void *poolAllocate(size_t bytes) {
+    const int c = sizeClass(bytes);
+    if (c >= kClasses)
+        return heapAllocate(bytes);
+    if (FreeBlock *block = state.free[c]) {
+        state.free[c] = block->next;
+        state.cached[c] -= kMinClassBytes << c;
+        return block;
+    }
+    touch();
+    return heapAllocate(kMinClassBytes << c);
+}
+
+void poolDeallocate(void *ptr, size_t bytes) {
+    const int c = sizeClass(bytes);
+    const size_t class_bytes = kMinClassBytes << c;
+    if (c >= kClasses || state.closed || state.cached[c] + class_bytes > kMaxCachedBytes) {
+        ::operator delete(ptr);
+        return;
+    }
+    touch();
+    auto *block = static_cast<FreeBlock *>(ptr);
+    block->next = state.free[c];
+    state.free[c] = block;
+    state.cached[c] += class_bytes;
+}
+
+size_t heapAllocations() {
+    return state.heap_allocations;
+}
+
+Workspace::Workspace() : _chunk(state.current_chunk), _offset(state.offset) {
+}
+
+Workspace::~Workspace() {
+    state.current_chunk = _chunk;
+    state.offset = _offset;
+}
+
+void *Workspace::allocateBytes(size_t bytes) {
+    bytes = (bytes + kWorkspaceAlign - 1) & ~(kWorkspaceAlign - 1);
+    if (state.current_chunk < state.chunk_count && state.offset + bytes <= state.chunks[state.current_chunk].size) {
+        void *ptr = state.chunks[state.current_chunk].data + state.offset;
+        state.offset += bytes;
+        return ptr;
+    }
+
+    // chunks after the current one hold nothing live, reuse the next one if it is large enough
+    const size_t next = (state.chunk_count == 0 ? 0 : state.current_chunk + 1);
+    if (next >= state.chunk_count || state.chunks[next].size < bytes) {
+        touch();
+        for (size_t i = next; i < state.chunk_count; i++)
+            ::operator delete(state.chunks[i].data, std::align_val_t(kWorkspaceAlign));
+        const size_t size = std::max({bytes, kFirstChunkBytes, next > 0 ? 2 * state.chunks[next - 1].size : 0});
+        state.heap_allocations++;
+        state.chunks[next] = {static_cast<char *>(::operator new(size, std::align_val_t(kWorkspaceAlign))), size};
+        state.chunk_count = next + 1;
+    }
+    state.current_chunk = next;
+    state.offset = bytes;
+    return state.chunks[next].data;
+}
+
+}
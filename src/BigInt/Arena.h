@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+
+// Thread-local memory for limb arrays, so that loops creating and destroying numbers
+// stop going to the global heap once they have warmed up.
+namespace limbs {
+
+// Size-class pool: requests are rounded up to a power of two (from 256 bytes) and freed blocks are kept
+// on per-thread free lists. A block may be freed on another thread than the one that allocated it.
+void *poolAllocate(size_t bytes);
+
+void poolDeallocate(void *ptr, size_t bytes);
+
+// Number of allocations the calling thread passed on to the global heap, pool and workspaces together
+size_t heapAllocations();
+
+// Allocator for SmallVector backed by the pool
+template<typename T>
+struct PoolAllocator {
+    static T *allocate(size_t n) {
+        return static_cast<T *>(poolAllocate(n * sizeof(T)));
+    }
+
+    static void deallocate(T *ptr, size_t n) {
+        poolDeallocate(ptr, n * sizeof(T));
+    }
+};
+
+// Scratch space on a thread-local bump stack. Everything allocated through a workspace is released at once
+// when it goes out of scope, workspaces on one thread must be destroyed in reverse order of creation.
+// The memory is kept for the next workspace, so steady-state scratch use costs a pointer bump.
+class Workspace {
+public:
+    Workspace();
+    ~Workspace();
+
+    Workspace(const Workspace &) = delete;
+    Workspace &operator=(const Workspace &) = delete;
+
+    // uninitialized, aligned to a cache line
+    template<typename T>
+    T *alloc(size_t n) {
+        return static_cast<T *>(allocateBytes(n * sizeof(T)));
+    }
+
+private:
+    void *allocateBytes(size_t bytes);
+
+    size_t _chunk, _offset;
+};
+
+}
@@ -5,8 +5,8 @@
 #include <cassert>
 #include "BigInt.h"
 
-const BigInt BigInt::ZERO("0");
-const BigInt BigInt::ONE("1");
+const BigInt BigInt::ZERO(0);
+const BigInt BigInt::ONE(1);
 
 
 BigInt::BigInt(const std::string &s) {
@@ -63,6 +63,49 @@ void BigInt::addOrSub(const BigInt &lhs, const BigInt &rhs, bool substract) {
     setSign(cmp_value * new_rhs_sign);
 }
 
+void BigInt::addMag(int rhs_sign, const BigUint &rhs_mag) {
+    if (sign == rhs_sign) {
+        mag += rhs_mag;
+        return;
+    }
+    if (mag.compareTo(rhs_mag) >= 0) {
+        mag -= rhs_mag;
+    } else {
+        mag.subtractFrom(rhs_mag);
+        sign = rhs_sign;
+    }
+    setSign(mag.isZero() ? 1 : sign);
+}
+
+void BigInt::addWord(int rhs_sign, limb_t rhs_mag) {
+    if (sign == rhs_sign) {
+        mag.addWord(rhs_mag);
+        return;
+    }
+    if (mag.data.size() > 1 || mag.data[0] >= rhs_mag) {
+        mag.subWord(rhs_mag);
+    } else {
+        mag.data[0] = rhs_mag - mag.data[0];
+        sign = rhs_sign;
+    }
+    setSign(mag.isZero() ? 1 : sign);
+}
+
+void BigInt::mulWord(int rhs_sign, limb_t rhs_mag) {
+    mag.mulWord(rhs_mag);
+    setSign(mag.isZero() ? 1 : sign * rhs_sign);
+}
+
+void BigInt::divWord(int rhs_sign, limb_t rhs_mag) {
+    mag.divModWord(rhs_mag);
+    setSign(mag.isZero() ? 1 : sign * rhs_sign);
+}
+
+void BigInt::modWord(limb_t rhs_mag) {
+    mag = mag.modWord(rhs_mag);
+    setSign(mag.isZero() ? 1 : sign);
+}
+
 BigInt operator+(const BigInt &lhs, const BigInt &rhs) {
     BigInt res;
     res.addOrSub(lhs, rhs, false);
@@ -132,29 +175,54 @@ bool BigInt::isZero() const {
     return sign == 1 && mag.isZero();
 }
 
-BigInt &BigInt::operator<<=(int size) {
-    mag <<= size;
+void BigInt::set_bit(size_t i, bool value) {
+    mag.set_bit(i, value);
+    setSign(mag.isZero() ? 1 : sign);
+}
+
+BigInt &BigInt::operator<<=(size_t bits) {
+    mag <<= bits;
     return *this;
 }
 
-BigInt &BigInt::operator>>=(int size) {
-    mag >>= size;
+BigInt &BigInt::operator>>=(size_t bits) {
+    mag >>= bits;
+    setSign(mag.isZero() ? 1 : sign);
     return *this;
 }
 
+BigInt operator<<(const BigInt &num, size_t bits) {
+    BigInt res = num;
+    res <<= bits;
+    return res;
+}
+
+BigInt operator>>(const BigInt &num, size_t bits) {
+    BigInt res = num;
+    res >>= bits;
+    return res;
+}
+
 BigInt operator/(const BigInt &lhs, const BigInt &rhs) {
-    BigInt res;
-    res.mag = lhs.mag / rhs.mag;
-    res.setSign((lhs.isZero() || rhs.isZero()) ? 1 : lhs.sign * rhs.sign); // TODO:check
+    BigInt res = lhs;
+    res /= rhs;
     return res;
 }
 
 BigInt operator%(const BigInt &lhs, const BigInt &rhs) {
-    BigInt res;
-    res = lhs - (lhs/rhs)*rhs;
+    BigInt res = lhs;
+    res %= rhs;
     return res;
 }
 
+void divrem(const BigInt &a, const BigInt &b, BigInt &q, BigInt &r) {
+    // signs are read first, as q or r may be a or b
+    const int a_sign = a.sign, b_sign = b.sign;
+    divMod(a.mag, b.mag, q.mag, r.mag);
+    q.setSign(q.mag.isZero() ? 1 : a_sign * b_sign);
+    r.setSign(r.mag.isZero() ? 1 : a_sign);
+}
+
 std::ostream &operator<<(std::ostream &os, const BigInt &num) {
     os << (num.sign==1?"":"-") + num.mag.to_string();
     return os;
@@ -166,9 +234,32 @@ std::istream &operator>>(std::istream &is, BigInt &num) {
     num = BigInt(s);
 }
 
+BigInt &BigInt::operator+=(const BigInt &rhs) {
+    addMag(rhs.sign, rhs.mag);
+    return *this;
+}
+
+BigInt &BigInt::operator-=(const BigInt &rhs) {
+    addMag(-rhs.sign, rhs.mag);
+    return *this;
+}
+
+BigInt &BigInt::operator*=(const BigInt &rhs) {
+    const int rhs_sign = rhs.sign;
+    mag *= rhs.mag;
+    setSign(mag.isZero() ? 1 : sign * rhs_sign);
+    return *this;
+}
+
+BigInt &BigInt::operator/=(const BigInt &rhs) {
+    const int rhs_sign = rhs.sign;
+    mag /= rhs.mag;
+    setSign(mag.isZero() ? 1 : sign * rhs_sign);
+    return *this;
+}
+
 BigInt &BigInt::operator%=(const BigInt &rhs) {
-    if(*this <= BigInt::ZERO || rhs <= BigInt::ZERO)
-        *this  = *this % rhs;
-    this->mag %= rhs.mag;
+    mag %= rhs.mag;
+    setSign(mag.isZero() ? 1 : sign);
     return *this;
 }
\ No newline at end of file
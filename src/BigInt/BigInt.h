@@ -29,23 +29,45 @@ public:
 
     BigInt(const std::string &s);
 
-    BigInt(int num) : BigInt(std::to_string(num)) {}
-
-    BigInt(long num) : BigInt(std::to_string(num)) {}
-
-    BigInt(long long num) : BigInt(std::to_string(num)) {}
+    template<std::integral T>
+    BigInt(T num) : sign(BigUint::isNegative(num) ? -1 : 1), mag(BigUint::magnitude(num)) {}
 
     bool isZero() const;
 
     void removeZeros();
 
     std::string to_string() const;
+
+    // non-negative number from its binary representation
+    static BigInt fromBytes(const uint8_t *bytes, size_t len, std::endian order = std::endian::big) {
+        BigInt res;
+        res.mag = BigUint::fromBytes(bytes, len, order);
+        return res;
+    }
+
+    // binary representation of the magnitude
+    std::vector<uint8_t> toBytes(std::endian order = std::endian::big) const {
+        return mag.toBytes(order);
+    }
     explicit operator int() const{
         return sign * int(mag);
     }
 
     void addOrSub(const BigInt &lhs, const BigInt &rhs, bool substract);
 
+    // *this += rhs_sign * rhs_mag in place, rhs_mag may be mag
+    void addMag(int rhs_sign, const BigUint &rhs_mag);
+
+    // *this op= rhs_sign * rhs_mag in O(n), used by operators with an integral operand
+    void addWord(int rhs_sign, limb_t rhs_mag);
+
+    void mulWord(int rhs_sign, limb_t rhs_mag);
+
+    void divWord(int rhs_sign, limb_t rhs_mag);
+
+    // remainder takes the sign of *this, as in operator%
+    void modWord(limb_t rhs_mag);
+
     int len(){return mag.len();}
 
 public:
@@ -53,11 +75,21 @@ public:
 
     BigInt operator-() const{
         BigInt res = *this;
-        if(!res.isZero())
-            res.sign *= -1;
+        res.negate();
         return res;
 
     }
+
+    friend BigInt operator-(BigInt &&num) {
+        num.negate();
+        return std::move(num);
+    }
+
+    // *this = -*this, zero keeps its positive sign
+    void negate() {
+        if(!isZero())
+            sign *= -1;
+    }
     friend BigInt operator+(const BigInt &lhs, const BigInt &rhs);
 
     friend BigInt operator-(const BigInt &lhs, const BigInt &rhs);
@@ -68,6 +100,158 @@ public:
 
     friend BigInt operator%(const BigInt &lhs, const BigInt &rhs);
 
+    // operators with an integral operand take the BigInt by value, so a temporary is reused
+    template<std::integral T>
+    friend BigInt operator+(BigInt lhs, T rhs) {
+        lhs += rhs;
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigInt operator+(T lhs, BigInt rhs) {
+        rhs += lhs;
+        return rhs;
+    }
+
+    template<std::integral T>
+    friend BigInt operator-(BigInt lhs, T rhs) {
+        lhs -= rhs;
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigInt operator-(T lhs, BigInt rhs) {
+        rhs.negate();
+        rhs += lhs;
+        return rhs;
+    }
+
+    template<std::integral T>
+    friend BigInt operator*(BigInt lhs, T rhs) {
+        lhs *= rhs;
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigInt operator*(T lhs, BigInt rhs) {
+        rhs *= lhs;
+        return rhs;
+    }
+
+    template<std::integral T>
+    friend BigInt operator/(BigInt lhs, T rhs) {
+        lhs /= rhs;
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigInt operator%(BigInt lhs, T rhs) {
+        lhs %= rhs;
+        return lhs;
+    }
+
+    template<std::integral T>
+    BigInt &operator+=(T rhs) {
+        addWord(BigUint::isNegative(rhs) ? -1 : 1, BigUint::magnitude(rhs));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInt &operator-=(T rhs) {
+        addWord(BigUint::isNegative(rhs) ? 1 : -1, BigUint::magnitude(rhs));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInt &operator*=(T rhs) {
+        mulWord(BigUint::isNegative(rhs) ? -1 : 1, BigUint::magnitude(rhs));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInt &operator/=(T rhs) {
+        divWord(BigUint::isNegative(rhs) ? -1 : 1, BigUint::magnitude(rhs));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInt &operator%=(T rhs) {
+        modWord(BigUint::magnitude(rhs));
+        return *this;
+    }
+
+    // In-place versions, the operand may be *this. / rounds toward zero and % takes the sign of *this.
+    BigInt &operator+=(const BigInt &rhs);
+
+    BigInt &operator-=(const BigInt &rhs);
+
+    BigInt &operator*=(const BigInt &rhs);
+
+    BigInt &operator/=(const BigInt &rhs);
+
+    BigInt &operator%=(const BigInt &rhs);
+
+    // Temporaries are updated in place and moved into the result
+    friend BigInt operator+(BigInt &&lhs, const BigInt &rhs) {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    friend BigInt operator+(const BigInt &lhs, BigInt &&rhs) {
+        rhs += lhs;
+        return std::move(rhs);
+    }
+
+    friend BigInt operator+(BigInt &&lhs, BigInt &&rhs) {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    friend BigInt operator-(BigInt &&lhs, const BigInt &rhs) {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    friend BigInt operator-(const BigInt &lhs, BigInt &&rhs) {
+        rhs.negate();
+        rhs += lhs;
+        return std::move(rhs);
+    }
+
+    friend BigInt operator-(BigInt &&lhs, BigInt &&rhs) {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    friend BigInt operator*(BigInt &&lhs, const BigInt &rhs) {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+
+    friend BigInt operator*(const BigInt &lhs, BigInt &&rhs) {
+        rhs *= lhs;
+        return std::move(rhs);
+    }
+
+    friend BigInt operator*(BigInt &&lhs, BigInt &&rhs) {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+
+    friend BigInt operator/(BigInt &&lhs, const BigInt &rhs) {
+        lhs /= rhs;
+        return std::move(lhs);
+    }
+
+    friend BigInt operator%(BigInt &&lhs, const BigInt &rhs) {
+        lhs %= rhs;
+        return std::move(lhs);
+    }
+
+    // q = a / b rounded toward zero and r = a - q * b with a single division.
+    // q and r must be different objects, either of them may be a or b.
+    friend void divrem(const BigInt &a, const BigInt &b, BigInt &q, BigInt &r);
+
     friend bool operator==(const BigInt &lhs, const BigInt &rhs);
 
     friend bool operator<(const BigInt &lhs, const BigInt &rhs);
@@ -80,11 +264,22 @@ public:
 
     friend bool operator!=(const BigInt &lhs, const BigInt &rhs);
 
-    BigInt& operator%=(const BigInt &rhs);
+    // bit operations act on the magnitude, so >> rounds toward zero
+    size_t bit_length() const { return mag.bit_length(); }
+
+    bool test_bit(size_t i) const { return mag.test_bit(i); }
+
+    void set_bit(size_t i, bool value = true);
+
+    size_t countr_zero() const { return mag.countr_zero(); }
+
+    BigInt &operator<<=(size_t bits);
+
+    BigInt &operator>>=(size_t bits);
 
-    BigInt &operator<<=(int size);
+    friend BigInt operator<<(const BigInt &num, size_t bits);
 
-    BigInt &operator>>=(int size);
+    friend BigInt operator>>(const BigInt &num, size_t bits);
 
     void setSign(int new_sign);
 
@@ -3,22 +3,127 @@
 //
 
 #include <algorithm>
+#include <bit>
+#include <cstring>
 #include <iterator>
 #include "BigUint.h"
+#include "Limbs.h"
 #include <iostream>
 
-const BigUint BigUint::ZERO("0");
-const BigUint BigUint::ONE("1");
+const BigUint BigUint::ZERO(0);
+const BigUint BigUint::ONE(1);
+
+namespace {
+
+// Numbers of at most this many limbs are converted to and from decimal chunk by chunk,
+// larger ones are split in two by a power 10^(19 * 2^k), see BigIntConversionBenchmark
+constexpr size_t kDecimalSplitLimbs = 40;
+
+// powers[k] = 10^(19 * 2^k), extended by squaring as needed
+const BigUint &decimalPower(std::vector<BigUint> &powers, size_t k) {
+    if (powers.empty())
+        powers.push_back(BigUint(BigUint::decimal_base));
+    while (powers.size() <= k)
+        powers.push_back(powers.back() * powers.back());
+    return powers[k];
+}
+
+BigUint parseDecimalChunks(const char *digits, size_t len) {
+    BigUint res;
+    size_t chunk = len % BigUint::decimal_base_len;
+    if (chunk == 0)
+        chunk = BigUint::decimal_base_len;
+    for (size_t i = 0; i < len; i += chunk, chunk = BigUint::decimal_base_len) {
+        limb_t mul = 1, add = 0;
+        for (size_t j = i; j < i + chunk; j++) {
+            mul *= 10;
+            add = add * 10 + (digits[j] - '0');
+        }
+        // res = res * mul + add
+        limb_t carry = limbs::mul_1(res.data.data(), res.data.data(), res.data.size(), mul);
+        carry += limbs::addTo(res.data.data(), res.data.size(), &add, 1);
+        if (carry)
+            res.data.push_back(carry);
+    }
+    res.removeZeros();
+    return res;
+}
+
+// value of digits[0..len) = high * 10^(19 * 2^k) + low, the low part takes at least half of the digits
+BigUint parseDecimal(const char *digits, size_t len, std::vector<BigUint> &powers) {
+    if (len <= kDecimalSplitLimbs * BigUint::decimal_base_len)
+        return parseDecimalChunks(digits, len);
+    size_t k = 0;
+    while ((size_t(BigUint::decimal_base_len) << (k + 1)) < len)
+        k++;
+    const size_t low_len = size_t(BigUint::decimal_base_len) << k;
+    BigUint res = parseDecimal(digits, len - low_len, powers) * decimalPower(powers, k);
+    return res + parseDecimal(digits + len - low_len, low_len, powers);
+}
+
+// base 10^19 chunks by repeated single-limb division, least significant first
+std::string decimalChunksToString(const BigUint &num) {
+    BigUint::LimbVector temp = num.data;
+    std::vector<limb_t> chunks;
+    while (temp.size() > 1 || temp.back() != 0) {
+        chunks.push_back(limbs::divWord(temp.data(), temp.data(), temp.size(), BigUint::decimal_base));
+        while (temp.size() > 1 && temp.back() == 0)
+            temp.pop_back();
+    }
+    if (chunks.empty())
+        return "0";
+
+    std::string result = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string limb = std::to_string(chunks[i]);
+        result.append(std::string(BigUint::decimal_base_len - limb.length(), '0').append(limb));
+    }
+    return result;
+}
+
+// appends num padded with zeros to width digits, width 0 means no padding
+void appendDecimal(const BigUint &num, size_t width, std::vector<BigUint> &powers, std::string &out) {
+    if (num.data.size() <= kDecimalSplitLimbs) {
+        std::string digits = decimalChunksToString(num);
+        if (width > digits.size())
+            out.append(width - digits.size(), '0');
+        out += digits;
+        return;
+    }
+    // smallest power with at least half of the limbs of num
+    size_t k = 0;
+    while (2 * decimalPower(powers, k).data.size() < num.data.size())
+        k++;
+    BigUint high, low;
+    divMod(num, powers[k], high, low);
+    const size_t low_width = size_t(BigUint::decimal_base_len) << k;
+    if (width > 0 || !high.isZero())
+        appendDecimal(high, (width > low_width ? width - low_width : 0), powers, out);
+    appendDecimal(low, low_width, powers, out);
+}
+
+limb_t loadLimb(const uint8_t *src, std::endian order) {
+    limb_t limb;
+    std::memcpy(&limb, src, sizeof(limb));
+    return (order == std::endian::native ? limb : __builtin_bswap64(limb));
+}
+
+void storeLimb(uint8_t *dst, limb_t limb, std::endian order) {
+    if (order != std::endian::native)
+        limb = __builtin_bswap64(limb);
+    std::memcpy(dst, &limb, sizeof(limb));
+}
+
+}
 
 BigUint::BigUint(const std::string &s) {
-    string temp(base_len, '0');
+    std::string digits;
     for (auto ch:s)
         if (isdigit(ch))
-            temp.push_back(ch);
-    for(int i = temp.size()-base_len; i >= 0; i -= base_len){
-        data.push_back(std::stoi(temp.substr(i,base_len)));
-    }
-    removeZeros();
+            digits.push_back(ch);
+
+    std::vector<BigUint> powers;
+    *this = parseDecimal(digits.data(), digits.size(), powers);
 }
 
 
@@ -32,14 +137,83 @@ void BigUint::removeZeros() {
 
 std::string BigUint::to_string() const {
     std::string result;
-    result.append(std::to_string(data.back()));
-    for(int i = data.size() - 2; i >= 0; i--) {
-        std::string limb = std::to_string(data[i]);
-        result.append(std::string(base_len - limb.length(), '0').append(limb));
-    }
+    std::vector<BigUint> powers;
+    appendDecimal(*this, 0, powers, result);
+    return result;
+}
+
+std::string BigUint::toHex() const {
+    static const char kHexDigits[] = "0123456789abcdef";
+    std::string result;
+    for (size_t i = std::max<size_t>((bit_length() + 3) / 4, 1); i-- > 0;)
+        result.push_back(kHexDigits[(data[i / 16] >> (4 * (i % 16))) & 15]);
     return result;
 }
 
+BigUint BigUint::fromHex(const std::string &s) {
+    const size_t start = (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X') ? 2 : 0);
+    const size_t len = s.size() - start;
+    BigUint res;
+    res.data.assign(std::max<size_t>((len + 15) / 16, 1), 0);
+    for (size_t i = 0; i < len; i++) {
+        const char ch = s[s.size() - 1 - i];
+        limb_t digit;
+        if (ch >= '0' && ch <= '9')
+            digit = ch - '0';
+        else if (ch >= 'a' && ch <= 'f')
+            digit = ch - 'a' + 10;
+        else if (ch >= 'A' && ch <= 'F')
+            digit = ch - 'A' + 10;
+        else
+            throw std::invalid_argument("invalid hex digit");
+        res.data[i / 16] |= digit << (4 * (i % 16));
+    }
+    res.removeZeros();
+    return res;
+}
+
+BigUint BigUint::fromBytes(const uint8_t *bytes, size_t len, std::endian order) {
+    const bool little = (order == std::endian::little);
+    const size_t full = len / sizeof(limb_t);
+    BigUint res;
+    res.data.assign(std::max<size_t>((len + sizeof(limb_t) - 1) / sizeof(limb_t), 1), 0);
+    for (size_t i = 0; i < full; i++) {
+        const uint8_t *src = (little ? bytes + i * sizeof(limb_t) : bytes + len - (i + 1) * sizeof(limb_t));
+        res.data[i] = loadLimb(src, order);
+    }
+    for (size_t j = full * sizeof(limb_t); j < len; j++)
+        res.data[full] |= limb_t(little ? bytes[j] : bytes[len - 1 - j]) << (8 * (j % sizeof(limb_t)));
+    res.removeZeros();
+    return res;
+}
+
+size_t BigUint::byteLength() const {
+    return (bit_length() + 7) / 8;
+}
+
+void BigUint::toBytes(uint8_t *out, size_t len, std::endian order) const {
+    if (byteLength() > len) {
+        throw std::length_error("BigUint does not fit into the buffer");
+    }
+    const bool little = (order == std::endian::little);
+    const size_t full = std::min(len / sizeof(limb_t), data.size());
+    for (size_t i = 0; i < full; i++) {
+        uint8_t *dst = (little ? out + i * sizeof(limb_t) : out + len - (i + 1) * sizeof(limb_t));
+        storeLimb(dst, data[i], order);
+    }
+    for (size_t j = full * sizeof(limb_t); j < len; j++) {
+        const size_t limb = j / sizeof(limb_t);
+        const uint8_t byte = (limb < data.size() ? uint8_t(data[limb] >> (8 * (j % sizeof(limb_t)))) : 0);
+        out[little ? j : len - 1 - j] = byte;
+    }
+}
+
+std::vector<uint8_t> BigUint::toBytes(std::endian order) const {
+    std::vector<uint8_t> bytes(byteLength());
+    toBytes(bytes.data(), bytes.size(), order);
+    return bytes;
+}
+
 bool operator==(const BigUint &lhs, const BigUint &rhs) {
     return lhs.compareTo(rhs) == 0;
 }
@@ -65,21 +239,76 @@ bool operator!=(const BigUint &lhs, const BigUint &rhs) {
 }
 
 
-BigUint &BigUint::operator<<=(int size) {
-    size_t initial_size = data.size();
-    data.resize(initial_size + size);
-    std::copy(data.begin(), data.begin() + initial_size, data.begin() + size);
-    std::fill(data.begin(), data.begin() + size, 0);
+size_t BigUint::bit_length() const {
+    return (data.size() - 1) * limb_bits + (limb_bits - std::countl_zero(data.back()));
+}
+
+bool BigUint::test_bit(size_t i) const {
+    return i / limb_bits < data.size() && (data[i / limb_bits] >> (i % limb_bits)) & 1;
+}
+
+void BigUint::set_bit(size_t i, bool value) {
+    const size_t limb = i / limb_bits;
+    if (limb >= data.size()) {
+        if (!value)
+            return;
+        data.resize(limb + 1);
+    }
+    const limb_t mask = limb_t(1) << (i % limb_bits);
+    data[limb] = (value ? data[limb] | mask : data[limb] & ~mask);
+    removeZeros();
+}
+
+size_t BigUint::countr_zero() const {
+    for (size_t i = 0; i < data.size(); i++)
+        if (data[i])
+            return i * limb_bits + std::countr_zero(data[i]);
+    return 0;
+}
+
+BigUint &BigUint::operator<<=(size_t bits) {
+    if (isZero())
+        return *this;
+    const size_t limb_shift = bits / limb_bits, n = data.size();
+    const int shift = bits % limb_bits;
+    // top limbs first, so every source limb is read before it is overwritten
+    data.resize(n + limb_shift + 1);
+    data[n + limb_shift] = (shift ? data[n - 1] >> (limb_bits - shift) : 0);
+    for (size_t i = n; i-- > 0;)
+        data[i + limb_shift] = (data[i] << shift) | (shift && i > 0 ? data[i - 1] >> (limb_bits - shift) : 0);
+    std::fill(data.begin(), data.begin() + limb_shift, 0);
+    removeZeros();
     return *this;
 }
 
-BigUint &BigUint::operator>>=(int size) {
-    std::copy(data.begin() + size, data.end(), data.begin());
-    data.resize(data.size() - size);
+BigUint &BigUint::operator>>=(size_t bits) {
+    const size_t limb_shift = bits / limb_bits, n = data.size();
+    const int shift = bits % limb_bits;
+    if (limb_shift >= n) {
+        data.assign(1, 0);
+        return *this;
+    }
+    for (size_t i = 0; i + limb_shift < n; i++) {
+        const size_t src = i + limb_shift;
+        data[i] = (data[src] >> shift) | (shift && src + 1 < n ? data[src + 1] << (limb_bits - shift) : 0);
+    }
+    data.resize(n - limb_shift);
     removeZeros();
     return *this;
 }
 
+BigUint operator<<(const BigUint &num, size_t bits) {
+    BigUint res = num;
+    res <<= bits;
+    return res;
+}
+
+BigUint operator>>(const BigUint &num, size_t bits) {
+    BigUint res = num;
+    res >>= bits;
+    return res;
+}
+
 
 int BigUint::compareTo(const BigUint &other) const{
     if (data.size() != other.data.size()) {
@@ -100,37 +329,50 @@ int BigUint::compareTo(const BigUint &other) const{
 
 
 
-void divMod(BigUint lhs, BigUint rhs, BigUint &div, BigUint &mod) {
-    if(rhs == 0){
+void BigUint::divModInPlace(const BigUint &rhs, BigUint *quotient) {
+    if (rhs.isZero()) {
         throw exception();
     }
-    BigUint z = 1;
-    int k = 0;
-    while(lhs >= rhs){
-        rhs <<= 1;
-        z <<= 1;
-        k++;
+    if (*this < rhs) {
+        if (quotient)
+            *quotient = ZERO;
+        return;
     }
 
-    while(k > 0){
-        rhs >>= 1;
-        z >>= 1;
-        k--;
-
-        limb_t l = 0, r = BigUint::base, x = 0;
-        while(l <= r){
-            limb_t m = l + (r-l)/2;
-            if(lhs >= rhs*m){
-                x = m;
-                l = m + 1;
-            }else{
-                r = m - 1;
-            }
-        }
-        lhs = lhs - rhs * x;
-        div = div + z * x;
+    const size_t n = rhs.data.size(), m = data.size() - n;
+    LimbVector q(quotient ? m + 1 : 0);
+    if (n == 1) {
+        limb_t rem = limbs::divWord(quotient ? q.data() : nullptr, data.data(), data.size(), rhs.data[0]);
+        data.assign(1, rem);
+    } else {
+        // normalize so that the top bit of divisor is set, divisor is copied first as it may alias quotient
+        const int shift = std::countl_zero(rhs.data.back());
+        LimbVector v(n);
+        limbs::shiftLeft(v.data(), rhs.data.data(), n, shift);
+        data.push_back(0);
+        limbs::shiftLeft(data.data(), data.data(), data.size(), shift);
+
+        limbs::divideNormalized(data.data(), m, v.data(), n, quotient ? q.data() : nullptr);
+
+        data.resize(n);
+        limbs::shiftRight(data.data(), data.data(), n, shift);
+        removeZeros();
+    }
+
+    if (quotient) {
+        quotient->data = std::move(q);
+        quotient->removeZeros();
+    }
+}
+
+void divMod(const BigUint &lhs, const BigUint &rhs, BigUint &div, BigUint &mod) {
+    if (&mod == &rhs) {
+        BigUint divisor = rhs;
+        divMod(lhs, divisor, div, mod);
+        return;
     }
     mod = lhs;
+    mod.divModInPlace(rhs, &div);
 }
 
 BigUint operator/(const BigUint &lhs, const BigUint &rhs) {
@@ -139,56 +381,42 @@ BigUint operator/(const BigUint &lhs, const BigUint &rhs) {
     return div;
 }
 
-
-
-BigUint &BigUint::operator%=(BigUint rhs) {
-    if(rhs.isZero()){
-        throw exception();
-    }
-    BigUint z = 1;
-    int k = 0;
-    while(*this >= rhs){
-        rhs <<= 1;
-        z <<= 1;
-        k++;
-    }
-
-    while(k > 0){
-        rhs >>= 1;
-        z >>= 1;
-        k--;
-
-        limb_t l = 0, r = BigUint::base, x = 0;
-        while(l <= r){
-            limb_t m = l + (r-l)/2;
-            if(*this >= rhs*m){
-                x = m;
-                l = m + 1;
-            }else{
-                r = m - 1;
-            }
-        }
-        *this = *this - rhs * x;
-    }
+BigUint &BigUint::operator%=(const BigUint &rhs) {
+    divModInPlace(rhs, nullptr);
     return *this;
 }
 
 BigUint operator%(const BigUint &lhs, const BigUint &rhs) {
-    BigUint div, mod;
-    divMod(lhs, rhs, div, mod);
+    BigUint mod = lhs;
+    mod %= rhs;
     return mod;
 }
 
 void BigUint::multiply(const BigUint &lhs, const BigUint &rhs) {
-    data.resize(lhs.data.size() + rhs.data.size());
-    for (std::size_t i = 0; i < lhs.data.size(); i++) {
-        limb_t carry = 0;
-        for (std::size_t j = 0; carry || j < rhs.data.size(); j++) {
-            limb_ll cur = data[i + j] + carry + limb_ll(lhs.data[i]) * (j < rhs.data.size() ? rhs.data[j] : 0);
-            data[i + j] = limb_t (cur % BigUint::base);
-            carry = limb_t(cur / BigUint::base);
-        }
+    if (&lhs == &rhs || lhs.data == rhs.data) {
+        square(lhs);
+        return;
     }
+    const BigUint &a = (lhs.data.size() >= rhs.data.size() ? lhs : rhs);
+    const BigUint &b = (lhs.data.size() >= rhs.data.size() ? rhs : lhs);
+    const size_t n = a.data.size(), m = b.data.size();
+
+    // result is built aside, so *this may be one of the operands
+    LimbVector result(n + m);
+    limbs::Workspace workspace;
+    limb_t *scratch = workspace.alloc<limb_t>(limbs::mulScratchSize(n, m));
+    limbs::mul(result.data(), a.data.data(), n, b.data.data(), m, scratch);
+    data = std::move(result);
+    removeZeros();
+}
+
+void BigUint::square(const BigUint &num) {
+    const size_t n = num.data.size();
+    LimbVector result(2 * n);
+    limbs::Workspace workspace;
+    limb_t *scratch = workspace.alloc<limb_t>(limbs::mulScratchSize(n, n));
+    limbs::sqr(result.data(), num.data.data(), n, scratch);
+    data = std::move(result);
     removeZeros();
 }
 
@@ -199,35 +427,118 @@ BigUint operator*(const BigUint &lhs, const BigUint &rhs) {
 }
 
 BigUint operator+(const BigUint &lhs, const BigUint &rhs) {
-    BigUint ans(lhs);
-    int carry = 0;
-    for (size_t i=0; i<max(ans.data.size(),rhs.data.size()) || carry; ++i) {
-        if (i == ans.data.size())
-            ans.data.push_back (0);
-        ans.data[i] += carry + (i < rhs.data.size() ? rhs.data[i] : 0);
-        carry = ans.data[i] >= BigUint::base;
-        if (carry)
-            ans.data[i] -= BigUint::base;
+    const BigUint &a = (lhs.data.size() >= rhs.data.size() ? lhs : rhs);
+    const BigUint &b = (lhs.data.size() >= rhs.data.size() ? rhs : lhs);
+    const size_t n = a.data.size(), m = b.data.size();
+    BigUint ans;
+    ans.data.resize(n + 1);
+    limb_t carry = limbs::add_n(ans.data.data(), a.data.data(), b.data.data(), m);
+    for (size_t i = m; i < n; i++) {
+        ans.data[i] = a.data[i] + carry;
+        carry = carry && ans.data[i] == 0;
     }
+    ans.data[n] = carry;
+    ans.removeZeros();
     return ans;
 }
 
 BigUint operator-(const BigUint &lhs, const BigUint &rhs) {
-    BigUint ans(lhs);
-    limb_t carry = 0;
-    for (size_t i=0, sz = rhs.data.size(); i<sz || carry; ++i) {
-        ans.data[i] += BigUint::base;
-        ans.data[i] -= carry + (i < sz ? rhs.data[i] : 0);
-        carry = ans.data[i] < BigUint::base;
-        if (!carry)
-            ans.data[i] -= BigUint::base;
+    const size_t n = lhs.data.size(), m = rhs.data.size();
+    if (m > n) {
+        throw std::logic_error("negative result for BigUint");
+    }
+    BigUint ans;
+    ans.data.resize(n);
+    limb_t borrow = limbs::sub_n(ans.data.data(), lhs.data.data(), rhs.data.data(), m);
+    for (size_t i = m; i < n; i++) {
+        ans.data[i] = lhs.data[i] - borrow;
+        borrow = borrow && lhs.data[i] == 0;
     }
     ans.removeZeros();
     return ans;
 }
 
+BigUint &BigUint::operator+=(const BigUint &rhs) {
+    // rhs is longer only if it is not *this, so growing does not move its limbs
+    if (data.size() < rhs.data.size())
+        data.resize(rhs.data.size(), 0);
+    if (limbs::addTo(data.data(), data.size(), rhs.data.data(), rhs.data.size()))
+        data.push_back(1);
+    return *this;
+}
+
+BigUint &BigUint::operator-=(const BigUint &rhs) {
+    if (compareTo(rhs) < 0) {
+        throw std::logic_error("negative result for BigUint");
+    }
+    limbs::subFrom(data.data(), data.size(), rhs.data.data(), rhs.data.size());
+    removeZeros();
+    return *this;
+}
+
+BigUint &BigUint::subtractFrom(const BigUint &lhs) {
+    if (compareTo(lhs) > 0) {
+        throw std::logic_error("negative result for BigUint");
+    }
+    const size_t n = lhs.data.size();
+    data.resize(n, 0);
+    limbs::sub_n(data.data(), lhs.data.data(), data.data(), n);
+    removeZeros();
+    return *this;
+}
+
+BigUint &BigUint::operator*=(const BigUint &rhs) {
+    multiply(*this, rhs);
+    return *this;
+}
+
+BigUint &BigUint::operator/=(const BigUint &rhs) {
+    divModInPlace(rhs, this);
+    return *this;
+}
+
+BigUint &BigUint::addWord(limb_t v) {
+    if (limbs::addTo(data.data(), data.size(), &v, 1))
+        data.push_back(1);
+    return *this;
+}
+
+BigUint &BigUint::subWord(limb_t v) {
+    if (data.size() == 1 && data[0] < v) {
+        throw std::logic_error("negative result for BigUint");
+    }
+    limbs::subFrom(data.data(), data.size(), &v, 1);
+    removeZeros();
+    return *this;
+}
+
+BigUint &BigUint::mulWord(limb_t v) {
+    limb_t high = limbs::mul_1(data.data(), data.data(), data.size(), v);
+    if (high)
+        data.push_back(high);
+    removeZeros();
+    return *this;
+}
+
+limb_t BigUint::divModWord(limb_t v) {
+    if (v == 0) {
+        throw exception();
+    }
+    limb_t rem = limbs::divWord(data.data(), data.data(), data.size(), v);
+    removeZeros();
+    return rem;
+}
+
+limb_t BigUint::modWord(limb_t v) const {
+    if (v == 0) {
+        throw exception();
+    }
+    return limbs::divWord(nullptr, data.data(), data.size(), v);
+}
+
 std::ostream &operator<<(std::ostream &os, const BigUint &num) {
     std::copy(num.data.rbegin(), num.data.rend(), std::ostream_iterator<limb_t>(os, "*"));
+    return os;
 }
 
 bool BigUint::isZero() const {
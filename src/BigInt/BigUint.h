@@ -5,11 +5,17 @@
 #ifndef BigUint_PROJECT_BIGUNSIGNED_H
 #define BigUint_PROJECT_BIGUNSIGNED_H
 
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <string>
+#include "Arena.h"
+#include "SmallVector.h"
 
-typedef unsigned limb_t;
-typedef unsigned long long limb_ll;
+typedef uint64_t limb_t;
+typedef unsigned __int128 limb_ll;
 
 using namespace std;
 class BigUint {
@@ -17,40 +23,169 @@ public:
     static const BigUint ZERO;
     static const BigUint ONE;
 
-    static const limb_t base = 1'000'000'000;
-    static const limb_t base_len = 9;
+    // limbs are binary (base 2^64), decimal base is used only for parsing and to_string
+    static const int limb_bits = 64;
+    static const limb_t decimal_base = 10'000'000'000'000'000'000ull;
+    static const int decimal_base_len = 19;
 
-    std::vector<limb_t> data;
+    // numbers up to inline_limbs limbs (products of 512-bit values) are stored without heap allocation,
+    // larger ones come from the thread-local limb pool
+    static const size_t inline_limbs = 16;
+    using LimbVector = SmallVector<limb_t, inline_limbs, limbs::PoolAllocator<limb_t>>;
+
+    LimbVector data;
 
     BigUint() : BigUint(0) {}
 
     BigUint(const std::string &s);
 
-    BigUint(int num) : BigUint(std::to_string(num)) {}
+    template<std::integral T>
+    BigUint(T num) : data{toWord(num)} {}
 
-    BigUint(limb_t num) : BigUint(std::to_string(num)) {}
+    template<std::integral T>
+    static constexpr bool isNegative(T num) {
+        if constexpr (std::is_signed_v<T>)
+            return num < 0;
+        else
+            return false;
+    }
 
-    BigUint(long long num) : BigUint(std::to_string(num)) {}
+    // |num| as a single limb
+    template<std::integral T>
+    static constexpr limb_t magnitude(T num) {
+        static_assert(sizeof(T) <= sizeof(limb_t));
+        return isNegative(num) ? limb_t(0) - limb_t(num) : limb_t(num);
+    }
+
+    // num as a single limb, throws for negative values
+    template<std::integral T>
+    static constexpr limb_t toWord(T num) {
+        if (isNegative(num))
+            throw std::logic_error("negative value for BigUint");
+        return magnitude(num);
+    }
 
     bool isZero() const;
 
     void removeZeros();
 
     int len() const{
-        return data.size() * base_len;
+        return data.size() * decimal_base_len;
     }
 
 
+    // decimal conversion splits large numbers in halves, so its cost follows multiplication and division
     std::string to_string() const;
+
+    // lowercase digits without prefix
+    std::string toHex() const;
+
+    // accepts an optional 0x prefix, throws std::invalid_argument for other characters
+    static BigUint fromHex(const std::string &s);
+
+    static BigUint fromBytes(const uint8_t *bytes, size_t len, std::endian order = std::endian::big);
+
+    // minimal number of bytes, 0 for zero
+    size_t byteLength() const;
+
+    // writes exactly len bytes with zero padding, throws std::length_error if the number does not fit
+    void toBytes(uint8_t *out, size_t len, std::endian order = std::endian::big) const;
+
+    std::vector<uint8_t> toBytes(std::endian order = std::endian::big) const;
     explicit operator int() const{
         return std::stoi(this->to_string());
     }
 
 public:
+    // *this = lhs * rhs, squares if both operands are equal
     void multiply(const BigUint &lhs, const BigUint &rhs);
 
+    // *this = num * num
+    void square(const BigUint &num);
+
     int compareTo(const BigUint &other) const;
 
+    // O(n) operations with a single limb operand, subWord throws std::logic_error if *this < v
+    BigUint &addWord(limb_t v);
+
+    BigUint &subWord(limb_t v);
+
+    BigUint &mulWord(limb_t v);
+
+    // *this /= v, returns the remainder
+    limb_t divModWord(limb_t v);
+
+    limb_t modWord(limb_t v) const;
+
+    // operators with an integral operand take the BigUint by value, so a temporary is reused
+    template<std::integral T>
+    friend BigUint operator+(BigUint lhs, T rhs) {
+        lhs.addWord(toWord(rhs));
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigUint operator+(T lhs, BigUint rhs) {
+        rhs.addWord(toWord(lhs));
+        return rhs;
+    }
+
+    template<std::integral T>
+    friend BigUint operator-(BigUint lhs, T rhs) {
+        lhs.subWord(toWord(rhs));
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigUint operator*(BigUint lhs, T rhs) {
+        lhs.mulWord(toWord(rhs));
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigUint operator*(T lhs, BigUint rhs) {
+        rhs.mulWord(toWord(lhs));
+        return rhs;
+    }
+
+    template<std::integral T>
+    friend BigUint operator/(BigUint lhs, T rhs) {
+        lhs.divModWord(toWord(rhs));
+        return lhs;
+    }
+
+    template<std::integral T>
+    friend BigUint operator%(const BigUint &lhs, T rhs) {
+        return lhs.modWord(toWord(rhs));
+    }
+
+    template<std::integral T>
+    BigUint &operator+=(T rhs) {
+        return addWord(toWord(rhs));
+    }
+
+    template<std::integral T>
+    BigUint &operator-=(T rhs) {
+        return subWord(toWord(rhs));
+    }
+
+    template<std::integral T>
+    BigUint &operator*=(T rhs) {
+        return mulWord(toWord(rhs));
+    }
+
+    template<std::integral T>
+    BigUint &operator/=(T rhs) {
+        divModWord(toWord(rhs));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigUint &operator%=(T rhs) {
+        data.assign(1, modWord(toWord(rhs)));
+        return *this;
+    }
+
     friend BigUint operator+(const BigUint &lhs, const BigUint &rhs);
 
     friend BigUint operator-(const BigUint &lhs, const BigUint &rhs);
@@ -61,7 +196,61 @@ public:
 
     friend BigUint operator%(const BigUint &lhs, const BigUint &rhs);
 
-    BigUint& operator%=(BigUint rhs);
+    // In-place versions, the operand may be *this. They grow the existing limbs instead of building
+    // a new number; -= throws std::logic_error if rhs > *this.
+    BigUint &operator+=(const BigUint &rhs);
+
+    BigUint &operator-=(const BigUint &rhs);
+
+    BigUint &operator*=(const BigUint &rhs);
+
+    BigUint &operator/=(const BigUint &rhs);
+
+    BigUint &operator%=(const BigUint &rhs);
+
+    // *this = lhs - *this, throws std::logic_error if *this > lhs
+    BigUint &subtractFrom(const BigUint &lhs);
+
+    // Temporaries are updated in place and moved into the result
+    friend BigUint operator+(BigUint &&lhs, const BigUint &rhs) {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    friend BigUint operator+(const BigUint &lhs, BigUint &&rhs) {
+        rhs += lhs;
+        return std::move(rhs);
+    }
+
+    friend BigUint operator+(BigUint &&lhs, BigUint &&rhs) {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    friend BigUint operator-(BigUint &&lhs, const BigUint &rhs) {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    friend BigUint operator-(const BigUint &lhs, BigUint &&rhs) {
+        rhs.subtractFrom(lhs);
+        return std::move(rhs);
+    }
+
+    friend BigUint operator-(BigUint &&lhs, BigUint &&rhs) {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    friend BigUint operator%(BigUint &&lhs, const BigUint &rhs) {
+        lhs %= rhs;
+        return std::move(lhs);
+    }
+
+    // *this becomes remainder of division by rhs, quotient is stored if not null
+    void divModInPlace(const BigUint &rhs, BigUint *quotient);
+
+    friend void divMod(const BigUint &lhs, const BigUint &rhs, BigUint &div, BigUint &mod);
 
     friend bool operator==(const BigUint &lhs, const BigUint &rhs);
 
@@ -75,9 +264,23 @@ public:
 
     friend bool operator!=(const BigUint &lhs, const BigUint &rhs);
 
-    BigUint &operator<<=(int size);
+    // number of significant bits, 0 for zero
+    size_t bit_length() const;
+
+    bool test_bit(size_t i) const;
+
+    void set_bit(size_t i, bool value = true);
+
+    // number of trailing zero bits, 0 for zero
+    size_t countr_zero() const;
+
+    BigUint &operator<<=(size_t bits);
+
+    BigUint &operator>>=(size_t bits);
+
+    friend BigUint operator<<(const BigUint &num, size_t bits);
 
-    BigUint &operator>>=(int size);
+    friend BigUint operator>>(const BigUint &num, size_t bits);
 
     friend std::ostream& operator<<(std::ostream &os, const BigUint &num);
 };
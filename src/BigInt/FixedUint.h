@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "BigInt.h"
+#include "Limbs.h"
+
+// Unsigned integer of exactly Bits bits kept in a std::array, for code that works at a known width
+// (EC fields, RSA moduli). No sign, no normalization and no heap: arithmetic wraps modulo 2^Bits.
+// add/sub/compare/select run the same instructions whatever the values are.
+template<size_t Bits>
+class FixedUint {
+    static_assert(Bits > 0 && Bits % BigUint::limb_bits == 0, "FixedUint width must be a whole number of limbs");
+
+    static constexpr int kBits = BigUint::limb_bits;
+
+    // f(0), f(1), ..., f(N - 1) with the index as a compile-time constant
+    template<size_t N, typename F>
+    static constexpr void unroll(F &&f) {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (f(std::integral_constant<size_t, I>{}), ...);
+        }(std::make_index_sequence<N>{});
+    }
+
+public:
+    static constexpr size_t kLimbs = Bits / BigUint::limb_bits;
+
+    // Products up to this many limbs are fully unrolled, larger ones go through limbs::mul
+    static constexpr size_t kUnrolledMulLimbs = 8;
+
+    std::array<limb_t, kLimbs> data{};
+
+    constexpr FixedUint() = default;
+
+    template<std::integral T>
+    constexpr FixedUint(T num) : data{BigUint::toWord(num)} {}
+
+    // throws std::length_error if num does not fit into Bits bits
+    explicit FixedUint(const BigUint &num) {
+        if (num.data.size() > kLimbs)
+            throw std::length_error("number does not fit into FixedUint");
+        std::copy(num.data.begin(), num.data.end(), data.begin());
+    }
+
+    explicit FixedUint(const BigInt &num) : FixedUint(num.mag) {
+        if (num.sign < 0 && !num.isZero())
+            throw std::logic_error("negative value for FixedUint");
+    }
+
+    BigUint toBigUint() const {
+        BigUint res;
+        res.data.resize(kLimbs);
+        std::copy(data.begin(), data.end(), res.data.begin());
+        res.removeZeros();
+        return res;
+    }
+
+    BigInt toBigInt() const {
+        BigInt res;
+        res.mag = toBigUint();
+        return res;
+    }
+
+    std::string to_string() const {
+        return toBigUint().to_string();
+    }
+
+    constexpr bool isZero() const {
+        limb_t acc = 0;
+        unroll<kLimbs>([&](auto i) { acc |= data[i]; });
+        return acc == 0;
+    }
+
+    constexpr bool test_bit(size_t i) const {
+        return i < Bits && (data[i / kBits] >> (i % kBits)) & 1;
+    }
+
+    // index of the highest set bit plus one, branches on the value
+    constexpr size_t bit_length() const {
+        for (size_t i = kLimbs; i-- > 0;)
+            if (data[i] != 0)
+                return i * kBits + std::bit_width(data[i]);
+        return 0;
+    }
+
+    // r = a + b mod 2^Bits, returns the carry, r may be a or b
+    static constexpr limb_t add(FixedUint &r, const FixedUint &a, const FixedUint &b) {
+        limb_t carry = 0;
+        unroll<kLimbs>([&](auto i) {
+            limb_ll cur = limb_ll(a.data[i]) + b.data[i] + carry;
+            r.data[i] = limb_t(cur);
+            carry = limb_t(cur >> kBits);
+        });
+        return carry;
+    }
+
+    // r = a - b mod 2^Bits, returns the borrow, r may be a or b
+    static constexpr limb_t sub(FixedUint &r, const FixedUint &a, const FixedUint &b) {
+        limb_t borrow = 0;
+        unroll<kLimbs>([&](auto i) {
+            limb_ll cur = limb_ll(a.data[i]) - b.data[i] - borrow;
+            r.data[i] = limb_t(cur);
+            borrow = limb_t(cur >> kBits) & 1;
+        });
+        return borrow;
+    }
+
+    // full 2 * Bits-bit product
+    constexpr FixedUint<2 * Bits> mulWide(const FixedUint &rhs) const {
+        FixedUint<2 * Bits> res;
+        if constexpr (kLimbs <= kUnrolledMulLimbs) {
+            unroll<kLimbs>([&](auto i) {
+                limb_t carry = 0;
+                unroll<kLimbs>([&](auto j) {
+                    limb_ll cur = limb_ll(data[j]) * rhs.data[i] + res.data[i + j] + carry;
+                    res.data[i + j] = limb_t(cur);
+                    carry = limb_t(cur >> kBits);
+                });
+                res.data[i + kLimbs] = carry;
+            });
+        } else if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < kLimbs; i++) {
+                limb_t carry = 0;
+                for (size_t j = 0; j < kLimbs; j++) {
+                    limb_ll cur = limb_ll(data[j]) * rhs.data[i] + res.data[i + j] + carry;
+                    res.data[i + j] = limb_t(cur);
+                    carry = limb_t(cur >> kBits);
+                }
+                res.data[i + kLimbs] = carry;
+            }
+        } else {
+            std::array<limb_t, limbs::mulScratchSize(kLimbs, kLimbs)> scratch;
+            limbs::mul(res.data.data(), data.data(), kLimbs, rhs.data.data(), kLimbs, scratch.data());
+        }
+        return res;
+    }
+
+    friend constexpr FixedUint operator+(const FixedUint &lhs, const FixedUint &rhs) {
+        FixedUint res;
+        add(res, lhs, rhs);
+        return res;
+    }
+
+    friend constexpr FixedUint operator-(const FixedUint &lhs, const FixedUint &rhs) {
+        FixedUint res;
+        sub(res, lhs, rhs);
+        return res;
+    }
+
+    // low Bits bits of the product
+    friend constexpr FixedUint operator*(const FixedUint &lhs, const FixedUint &rhs) {
+        auto wide = lhs.mulWide(rhs);
+        FixedUint res;
+        std::copy(wide.data.begin(), wide.data.begin() + kLimbs, res.data.begin());
+        return res;
+    }
+
+    // num % mod for num of any width, throws for zero mod
+    template<size_t NumBits>
+    static FixedUint reduce(const FixedUint<NumBits> &num, const FixedUint &mod) {
+        size_t n = FixedUint<NumBits>::kLimbs, m = kLimbs;
+        while (n > 0 && num.data[n - 1] == 0)
+            n--;
+        while (m > 0 && mod.data[m - 1] == 0)
+            m--;
+        if (m == 0)
+            throw exception();
+        FixedUint res;
+        if (n < m) {
+            std::copy(num.data.begin(), num.data.begin() + n, res.data.begin());
+            return res;
+        }
+        std::array<limb_t, FixedUint<NumBits>::kLimbs + kLimbs + 1> scratch;
+        limbs::divRem(nullptr, res.data.data(), num.data.data(), n, mod.data.data(), m, scratch.data());
+        return res;
+    }
+
+    friend FixedUint operator%(const FixedUint &lhs, const FixedUint &rhs) {
+        return reduce(lhs, rhs);
+    }
+
+    // -1, 0 or 1, from the borrows of both subtractions
+    static constexpr int compare(const FixedUint &lhs, const FixedUint &rhs) {
+        FixedUint diff;
+        const limb_t less = sub(diff, lhs, rhs);
+        const limb_t greater = sub(diff, rhs, lhs);
+        return int(greater) - int(less);
+    }
+
+    // condition ? a : b, through a mask instead of a branch
+    static constexpr FixedUint select(limb_t condition, const FixedUint &a, const FixedUint &b) {
+        const limb_t mask = limb_t(0) - limb_t(condition != 0);
+        FixedUint res;
+        unroll<kLimbs>([&](auto i) { res.data[i] = (a.data[i] & mask) | (b.data[i] & ~mask); });
+        return res;
+    }
+
+    friend constexpr bool operator==(const FixedUint &lhs, const FixedUint &rhs) {
+        limb_t acc = 0;
+        unroll<kLimbs>([&](auto i) { acc |= lhs.data[i] ^ rhs.data[i]; });
+        return acc == 0;
+    }
+
+    friend constexpr bool operator!=(const FixedUint &lhs, const FixedUint &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const FixedUint &lhs, const FixedUint &rhs) {
+        FixedUint diff;
+        return sub(diff, lhs, rhs) != 0;
+    }
+
+    friend constexpr bool operator>(const FixedUint &lhs, const FixedUint &rhs) {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const FixedUint &lhs, const FixedUint &rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const FixedUint &lhs, const FixedUint &rhs) {
+        return !(lhs < rhs);
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const FixedUint &num) {
+        return out << num.to_string();
+    }
+};
@@ -0,0 +1,308 @@
+#include "Limbs.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#define LIMBS_X86_64_ASM 1
+#endif
+
+// Innermost loops over equal-length limb arrays. Every kernel has a portable version and
+// an x86-64 version built on MULX/ADCX/ADOX, the latter is picked at startup if the CPU has it.
+namespace limbs {
+
+constexpr int kBits = BigUint::limb_bits;
+
+namespace portable {
+
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        limb_ll cur = limb_ll(a[i]) + b[i] + carry;
+        r[i] = limb_t(cur);
+        carry = limb_t(cur >> kBits);
+    }
+    return carry;
+}
+
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t borrow = 0;
+    for (size_t i = 0; i < n; i++) {
+        limb_ll cur = limb_ll(a[i]) - b[i] - borrow;
+        r[i] = limb_t(cur);
+        borrow = limb_t(cur >> kBits) & 1;
+    }
+    return borrow;
+}
+
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        limb_ll cur = limb_ll(a[i]) * v + carry;
+        r[i] = limb_t(cur);
+        carry = limb_t(cur >> kBits);
+    }
+    return carry;
+}
+
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        limb_ll cur = limb_ll(a[i]) * v + r[i] + carry;
+        r[i] = limb_t(cur);
+        carry = limb_t(cur >> kBits);
+    }
+    return carry;
+}
+
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    limb_t borrow = 0;
+    for (size_t i = 0; i < n; i++) {
+        limb_ll prod = limb_ll(a[i]) * v + borrow;
+        limb_t lo = limb_t(prod);
+        borrow = limb_t(prod >> kBits) + (r[i] < lo);
+        r[i] -= lo;
+    }
+    return borrow;
+}
+
+}
+
+namespace adx {
+
+#ifdef LIMBS_X86_64_ASM
+
+bool supported() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    constexpr unsigned kBmi2 = 1u << 8, kAdx = 1u << 19;
+    return (ebx & kBmi2) && (ebx & kAdx);
+}
+
+// Loops run a negative index up to zero with lea and jrcxz, neither of which touches the flags,
+// so carries stay in CF (and OF) across iterations.
+
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    if (n == 0)
+        return 0;
+    limb_t carry = 0, tmp;
+    long i = -long(n);
+    __asm__(
+        "xor %k[t], %k[t]\n\t"
+        "1:\n\t"
+        "mov (%[a],%[i],8), %[t]\n\t"
+        "adc (%[b],%[i],8), %[t]\n\t"
+        "mov %[t], (%[r],%[i],8)\n\t"
+        "lea 1(%[i]), %[i]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "adc $0, %[c]\n\t"
+        : [c] "+r"(carry), [i] "+&c"(i), [t] "=&r"(tmp)
+        : [r] "r"(r + n), [a] "r"(a + n), [b] "r"(b + n)
+        : "cc", "memory");
+    return carry;
+}
+
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    if (n == 0)
+        return 0;
+    limb_t borrow = 0, tmp;
+    long i = -long(n);
+    __asm__(
+        "xor %k[t], %k[t]\n\t"
+        "1:\n\t"
+        "mov (%[a],%[i],8), %[t]\n\t"
+        "sbb (%[b],%[i],8), %[t]\n\t"
+        "mov %[t], (%[r],%[i],8)\n\t"
+        "lea 1(%[i]), %[i]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "adc $0, %[c]\n\t"
+        : [c] "+r"(borrow), [i] "+&c"(i), [t] "=&r"(tmp)
+        : [r] "r"(r + n), [a] "r"(a + n), [b] "r"(b + n)
+        : "cc", "memory");
+    return borrow;
+}
+
+// The multiply loops are unrolled twice, an odd first limb is handled by the portable code.
+
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    limb_t carry = 0, lo, hi;
+    if (n % 2) {
+        carry = portable::mul_1(r++, a++, 1, v);
+        n--;
+    }
+    if (n == 0)
+        return carry;
+    long i = -long(n);
+    __asm__(
+        "xor %k[lo], %k[lo]\n\t"
+        "1:\n\t"
+        "mulx (%[a],%[i],8), %[lo], %[hi]\n\t"
+        "adcx %[c], %[lo]\n\t"
+        "mov %[lo], (%[r],%[i],8)\n\t"
+        "mulx 8(%[a],%[i],8), %[lo], %[c]\n\t"
+        "adcx %[hi], %[lo]\n\t"
+        "mov %[lo], 8(%[r],%[i],8)\n\t"
+        "lea 2(%[i]), %[i]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %k[lo]\n\t"
+        "adcx %[lo], %[c]\n\t"
+        : [c] "+&r"(carry), [i] "+&c"(i), [lo] "=&r"(lo), [hi] "=&r"(hi)
+        : [r] "r"(r + n), [a] "r"(a + n), "d"(v)
+        : "cc", "memory");
+    return carry;
+}
+
+// Two carry chains: CF adds the high half of the previous product, OF adds r[i].
+// The final carry is at most B - 1 since a*v + r < B^(n+1).
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    limb_t carry = 0, lo, hi;
+    if (n % 2) {
+        carry = portable::addmul_1(r++, a++, 1, v);
+        n--;
+    }
+    if (n == 0)
+        return carry;
+    long i = -long(n);
+    __asm__(
+        "xor %k[lo], %k[lo]\n\t"
+        "1:\n\t"
+        "mulx (%[a],%[i],8), %[lo], %[hi]\n\t"
+        "adcx %[c], %[lo]\n\t"
+        "adox (%[r],%[i],8), %[lo]\n\t"
+        "mov %[lo], (%[r],%[i],8)\n\t"
+        "mulx 8(%[a],%[i],8), %[lo], %[c]\n\t"
+        "adcx %[hi], %[lo]\n\t"
+        "adox 8(%[r],%[i],8), %[lo]\n\t"
+        "mov %[lo], 8(%[r],%[i],8)\n\t"
+        "lea 2(%[i]), %[i]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %k[lo]\n\t"
+        "adcx %[lo], %[c]\n\t"
+        "adox %[lo], %[c]\n\t"
+        : [c] "+&r"(carry), [i] "+&c"(i), [lo] "=&r"(lo), [hi] "=&r"(hi)
+        : [r] "r"(r + n), [a] "r"(a + n), "d"(v)
+        : "cc", "memory");
+    return carry;
+}
+
+// r - p = ~(~r + p), so the OF chain adds the product to the complement of r
+// and its carry is the borrow of the subtraction.
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    limb_t borrow = 0, lo, hi, tmp;
+    if (n % 2) {
+        borrow = portable::submul_1(r++, a++, 1, v);
+        n--;
+    }
+    if (n == 0)
+        return borrow;
+    long i = -long(n);
+    __asm__(
+        "xor %k[lo], %k[lo]\n\t"
+        "1:\n\t"
+        "mulx (%[a],%[i],8), %[lo], %[hi]\n\t"
+        "adcx %[c], %[lo]\n\t"
+        "mov (%[r],%[i],8), %[t]\n\t"
+        "not %[t]\n\t"
+        "adox %[t], %[lo]\n\t"
+        "not %[lo]\n\t"
+        "mov %[lo], (%[r],%[i],8)\n\t"
+        "mulx 8(%[a],%[i],8), %[lo], %[c]\n\t"
+        "adcx %[hi], %[lo]\n\t"
+        "mov 8(%[r],%[i],8), %[t]\n\t"
+        "not %[t]\n\t"
+        "adox %[t], %[lo]\n\t"
+        "not %[lo]\n\t"
+        "mov %[lo], 8(%[r],%[i],8)\n\t"
+        "lea 2(%[i]), %[i]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %k[lo]\n\t"
+        "adcx %[lo], %[c]\n\t"
+        "adox %[lo], %[c]\n\t"
+        : [c] "+&r"(borrow), [i] "+&c"(i), [lo] "=&r"(lo), [hi] "=&r"(hi), [t] "=&r"(tmp)
+        : [r] "r"(r + n), [a] "r"(a + n), "d"(v)
+        : "cc", "memory");
+    return borrow;
+}
+
+#else
+
+bool supported() {
+    return false;
+}
+
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    return portable::add_n(r, a, b, n);
+}
+
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    return portable::sub_n(r, a, b, n);
+}
+
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    return portable::mul_1(r, a, n, v);
+}
+
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    return portable::addmul_1(r, a, n, v);
+}
+
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    return portable::submul_1(r, a, n, v);
+}
+
+#endif
+
+}
+
+namespace {
+
+struct Kernels {
+    limb_t (*add_n)(limb_t *, const limb_t *, const limb_t *, size_t);
+    limb_t (*sub_n)(limb_t *, const limb_t *, const limb_t *, size_t);
+    limb_t (*mul_1)(limb_t *, const limb_t *, size_t, limb_t);
+    limb_t (*addmul_1)(limb_t *, const limb_t *, size_t, limb_t);
+    limb_t (*submul_1)(limb_t *, const limb_t *, size_t, limb_t);
+};
+
+// constant-initialized, so static constructors of other files that run first get the portable kernels
+Kernels kernels = {portable::add_n, portable::sub_n, portable::mul_1, portable::addmul_1, portable::submul_1};
+
+[[maybe_unused]] const bool adx_selected = [] {
+    if (!adx::supported())
+        return false;
+    kernels = {adx::add_n, adx::sub_n, adx::mul_1, adx::addmul_1, adx::submul_1};
+    return true;
+}();
+
+}
+
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    return kernels.add_n(r, a, b, n);
+}
+
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    return kernels.sub_n(r, a, b, n);
+}
+
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    return kernels.mul_1(r, a, n, v);
+}
+
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    return kernels.addmul_1(r, a, n, v);
+}
+
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t v) {
+    return kernels.submul_1(r, a, n, v);
+}
+
+}
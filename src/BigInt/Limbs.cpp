@@ -0,0 +1,520 @@
+#include <algorithm>
+#include <bit>
+#include <initializer_list>
+#include <omp.h>
+#include "Limbs.h"
+
+namespace limbs {
+
+constexpr int kBits = BigUint::limb_bits;
+
+bool canStartParallel() {
+    return !omp_in_parallel() && omp_get_max_threads() > 1;
+}
+
+limb_t addTo(limb_t *x, size_t xn, const limb_t *y, size_t yn) {
+    limb_t carry = add_n(x, x, y, yn);
+    for (size_t i = yn; carry && i < xn; i++) {
+        carry = (++x[i] == 0);
+    }
+    return carry;
+}
+
+limb_t subFrom(limb_t *x, size_t xn, const limb_t *y, size_t yn) {
+    limb_t borrow = sub_n(x, x, y, yn);
+    for (size_t i = yn; borrow && i < xn; i++) {
+        borrow = (x[i]-- == 0);
+    }
+    return borrow;
+}
+
+limb_t addMulTo(limb_t *x, size_t xn, const limb_t *y, size_t yn, limb_t v) {
+    limb_t carry = addmul_1(x, y, yn, v);
+    if (yn == xn)
+        return carry;
+    return addTo(x + yn, xn - yn, &carry, 1);
+}
+
+limb_t subMulFrom(limb_t *x, size_t xn, const limb_t *y, size_t yn, limb_t v) {
+    limb_t borrow = submul_1(x, y, yn, v);
+    if (yn == xn)
+        return borrow;
+    return subFrom(x + yn, xn - yn, &borrow, 1);
+}
+
+int compare(const limb_t *x, size_t xn, const limb_t *y, size_t yn) {
+    for (size_t i = std::max(xn, yn); i-- > 0;) {
+        limb_t xi = (i < xn ? x[i] : 0), yi = (i < yn ? y[i] : 0);
+        if (xi != yi)
+            return (xi > yi ? 1 : -1);
+    }
+    return 0;
+}
+
+limb_t divWord(limb_t *q, const limb_t *a, size_t n, limb_t v) {
+    const int shift = std::countl_zero(v);
+    if ((v & (v - 1)) == 0) {
+        // power of two, plain shift
+        const int bits = kBits - 1 - shift;
+        if (q && bits == 0) {
+            std::copy(a, a + n, q);
+        } else if (q) {
+            for (size_t i = 0; i + 1 < n; i++)
+                q[i] = (a[i] >> bits) | (a[i + 1] << (kBits - bits));
+            q[n - 1] = a[n - 1] >> bits;
+        }
+        return a[0] & (v - 1);
+    }
+
+    // Moller, Granlund, "Improved division by invariant integers", Algorithm 4.
+    // Both divisor and dividend are shifted so that the top bit of the divisor is set.
+    const limb_t d = v << shift;
+    const limb_t inv = limb_t(~limb_ll(0) / d); // floor((B^2 - 1) / d) - B
+    limb_t rem = (shift ? a[n - 1] >> (kBits - shift) : 0);
+    for (size_t i = n; i-- > 0;) {
+        const limb_t u0 = (a[i] << shift) | (shift && i > 0 ? a[i - 1] >> (kBits - shift) : 0);
+        limb_ll p = limb_ll(inv) * rem + ((limb_ll(rem) << kBits) | u0);
+        limb_t q1 = limb_t(p >> kBits) + 1, q0 = limb_t(p);
+        limb_t r = u0 - q1 * d;
+        if (r > q0) {
+            q1--;
+            r += d;
+        }
+        if (r >= d) {
+            q1++;
+            r -= d;
+        }
+        if (q)
+            q[i] = q1;
+        rem = r;
+    }
+    return rem >> shift;
+}
+
+void shiftLeft(limb_t *dst, const limb_t *src, size_t n, int shift) {
+    if (shift == 0) {
+        std::copy(src, src + n, dst);
+        return;
+    }
+    for (size_t i = n - 1; i > 0; i--)
+        dst[i] = (src[i] << shift) | (src[i - 1] >> (kBits - shift));
+    dst[0] = src[0] << shift;
+}
+
+void shiftRight(limb_t *dst, const limb_t *src, size_t n, int shift) {
+    if (shift == 0) {
+        std::copy(src, src + n, dst);
+        return;
+    }
+    for (size_t i = 0; i + 1 < n; i++)
+        dst[i] = (src[i] >> shift) | (src[i + 1] << (kBits - shift));
+    dst[n - 1] = src[n - 1] >> shift;
+}
+
+void divideKnuth(limb_t *u, size_t m, const limb_t *v, size_t n, limb_t *q) {
+    const limb_t v1 = v[n - 1], v2 = v[n - 2];
+    for (size_t j = m + 1; j-- > 0;) {
+        // estimate quotient digit from the top limbs, it is at most 2 too large
+        limb_ll num = (limb_ll(u[j + n]) << kBits) | u[j + n - 1];
+        limb_ll qhat = num / v1, rhat = num % v1;
+        while ((qhat >> kBits) || qhat * v2 > ((rhat << kBits) | u[j + n - 2])) {
+            qhat--;
+            rhat += v1;
+            if (rhat >> kBits)
+                break;
+        }
+
+        // u[j..j+n] -= qhat * v
+        limb_t borrow = submul_1(u + j, v, n, limb_t(qhat));
+        limb_t top = u[j + n];
+        u[j + n] = top - borrow;
+
+        if (top < borrow) {
+            // qhat was one too large, add v back
+            qhat--;
+            u[j + n] += add_n(u + j, u + j, v, n);
+        }
+        if (q)
+            q[j] = limb_t(qhat);
+    }
+}
+
+namespace {
+
+// x[0..n] within a few units of floor((B^2n - 1) / v[0..n)).
+// v = vh*B^l + vl, xh ~ B^2h / vh, e = B^(n+h) - v*xh is below B^(n+1) in absolute value,
+// then x = xh*B^l + xh*e / B^2h. One limb more than half of v keeps the error of x from growing with the depth.
+void approxReciprocal(limb_t *x, const limb_t *v, size_t n) {
+    if (n < kDivNewtonThreshold) {
+        Workspace workspace;
+        limb_t *u = workspace.alloc<limb_t>(2 * n + 1);
+        std::fill(u, u + 2 * n, ~limb_t(0));
+        u[2 * n] = 0;
+        divideKnuth(u, n, v, n, x);
+        return;
+    }
+    const size_t h = (n + 1) / 2 + 1, l = n - h;
+    Workspace workspace;
+    limb_t *xh = workspace.alloc<limb_t>((h + 1) + (n + h + 1) + (n + h + 2) + mulScratchSize(n, h + 1)), *t = xh + h + 1, *p = t + n + h + 1, *scratch = p + n + h + 2;
+
+    approxReciprocal(xh, v + l, h);
+    mul(t, v, n, xh, h + 1, scratch);
+    const bool negative = (t[n + h] != 0);
+    if (!negative) {
+        // B^(n+h) - t as the two's complement of t[0..n+h)
+        for (size_t i = 0; i < n + h; i++)
+            t[i] = ~t[i];
+        const limb_t one = 1;
+        addTo(t, n + h, &one, 1);
+    }
+    mul(p, t, n + 1, xh, h + 1, scratch);
+
+    std::fill(x, x + l, 0);
+    std::copy(xh, xh + h + 1, x + l);
+    if (negative)
+        subFrom(x, n + 1, p + 2 * h, l + 2);
+    else
+        addTo(x, n + 1, p + 2 * h, l + 2);
+}
+
+}
+
+void reciprocal(limb_t *x, const limb_t *v, size_t n) {
+    approxReciprocal(x, v, n);
+
+    // v*x <= B^2n - 1 < v*(x + 1)
+    Workspace workspace;
+    limb_t *r = workspace.alloc<limb_t>(2 * n + 1), *scratch = workspace.alloc<limb_t>(mulScratchSize(n + 1, n));
+    const limb_t one = 1;
+    mul(r, x, n + 1, v, n, scratch);
+    while (r[2 * n] != 0) {
+        subFrom(x, n + 1, &one, 1);
+        subFrom(r, 2 * n + 1, v, n);
+    }
+    while (addTo(r, 2 * n, v, n) == 0) {
+        addTo(x, n + 1, &one, 1);
+    }
+}
+
+void divideNewton(limb_t *u, size_t m, const limb_t *v, size_t n, limb_t *q) {
+    Workspace workspace;
+    limb_t *x = workspace.alloc<limb_t>((n + 1) + (2 * n + 1) + 2 * n + mulScratchSize(n + 1, n)), *prod = x + n + 1, *qv = prod + 2 * n + 1, *scratch = qv + 2 * n;
+    reciprocal(x, v, n);
+
+    const limb_t one = 1;
+    for (size_t pos = m + 1; pos > 0;) {
+        // A = u[pos..pos+n+c) < v*B^c gives c quotient limbs. Estimating from floor(A / B^n) and x
+        // truncates everything downwards, the estimate is at most 3 below the quotient.
+        const size_t c = std::min(n, pos);
+        pos -= c;
+        limb_t *a = u + pos;
+        mul(prod, x, n + 1, a + n, c, scratch);
+        limb_t *qe = prod + n;
+        mul(qv, v, n, qe, c, scratch);
+        subFrom(a, n + c, qv, n + c);
+        while (compare(a, n + c, v, n) >= 0) {
+            subFrom(a, n + c, v, n);
+            addTo(qe, c, &one, 1);
+        }
+        if (q)
+            std::copy(qe, qe + c, q + pos);
+    }
+}
+
+void divideNormalized(limb_t *u, size_t m, const limb_t *v, size_t n, limb_t *q) {
+    if (n >= kDivNewtonThreshold && m + 1 >= kDivNewtonThreshold)
+        divideNewton(u, m, v, n, q);
+    else
+        divideKnuth(u, m, v, n, q);
+}
+
+void divRem(limb_t *q, limb_t *r, const limb_t *a, size_t n, const limb_t *d, size_t m, limb_t *scratch) {
+    if (m == 1) {
+        r[0] = divWord(q, a, n, d[0]);
+        return;
+    }
+    limb_t *u = scratch, *v = scratch + n + 1;
+    const int shift = std::countl_zero(d[m - 1]);
+    shiftLeft(v, d, m, shift);
+    u[n] = (shift ? a[n - 1] >> (kBits - shift) : 0);
+    shiftLeft(u, a, n, shift);
+    divideNormalized(u, n - m, v, m, q);
+    shiftRight(r, u, m, shift);
+}
+
+namespace {
+
+// out[0..len) = |x - y|, returns true if x < y
+bool absDiff(limb_t *out, const limb_t *x, size_t xn, const limb_t *y, size_t yn, size_t len) {
+    bool negative = compare(x, xn, y, yn) < 0;
+    if (negative) {
+        std::swap(x, y);
+        std::swap(xn, yn);
+    }
+    std::fill(std::copy(x, x + xn, out), out + len, 0);
+    subFrom(out, len, y, yn);
+    return negative;
+}
+
+// x[0..xn) += y, ignoring zero top limbs of y that do not fit into x
+void addTrimmed(limb_t *x, size_t xn, const limb_t *y, size_t yn) {
+    while (yn > xn && y[yn - 1] == 0)
+        yn--;
+    addTo(x, xn, y, yn);
+}
+
+void shiftRight1(limb_t *x, size_t n) {
+    for (size_t i = 0; i + 1 < n; i++)
+        x[i] = (x[i] >> 1) | (x[i + 1] << (kBits - 1));
+    x[n - 1] >>= 1;
+}
+
+void divideBy3(limb_t *x, size_t n) {
+    limb_ll rem = 0;
+    for (size_t i = n; i-- > 0;) {
+        limb_ll cur = (rem << kBits) | x[i];
+        x[i] = limb_t(cur / 3);
+        rem = cur % 3;
+    }
+}
+
+// b is split into chunks of m limbs, chunk products are accumulated into r
+void mulUnbalanced(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limb_t *scratch) {
+    limb_t *tmp = scratch, *next = scratch + 2 * m;
+    mul(r, a, m, b, m, next);
+    for (size_t i = m; i < n; i += m) {
+        const size_t c = std::min(m, n - i);
+        if (c == m)
+            mul(tmp, a + i, m, b, m, next);
+        else
+            mul(tmp, b, m, a + i, c, next);
+        // r[i..i+m) holds upper half of the previous chunk product
+        std::copy(tmp + m, tmp + m + c, r + i + m);
+        limb_t carry = addTo(r + i, m, tmp, m);
+        addTo(r + i + m, c, &carry, 1);
+    }
+}
+
+// Evaluates a0 + a1*x + a2*x^2 at 1, -1 and 2, each result has k + 1 limbs, returns sign of value at -1
+bool toom3Evaluate(const limb_t *a, size_t k, size_t n2, limb_t *at1, limb_t *at_minus1, limb_t *at2) {
+    const limb_t *a0 = a, *a1 = a + k, *a2 = a + 2 * k;
+    std::fill(std::copy(a0, a0 + k, at1), at1 + k + 1, 0);
+    addTo(at1, k + 1, a2, n2);
+    bool negative = absDiff(at_minus1, at1, k + 1, a1, k, k + 1);
+    addTo(at1, k + 1, a1, k);
+
+    std::fill(std::copy(a0, a0 + k, at2), at2 + k + 1, 0);
+    addMulTo(at2, k + 1, a1, k, 2);
+    addMulTo(at2, k + 1, a2, n2, 4);
+    return negative;
+}
+
+// r[h..rn) += z0 + z2 -/+ prod, where z0 = r[0..2h) and z2 = r[2h..rn), prod has 2hh limbs,
+// t is a temporary of 2hh + 1 limbs
+void karatsubaCombine(limb_t *r, size_t rn, size_t h, size_t hh, const limb_t *prod, bool add_prod, limb_t *t) {
+    const size_t tn = 2 * hh + 1;
+    std::fill(std::copy(r, r + 2 * h, t), t + tn, 0);
+    addTo(t, tn, r + 2 * h, rn - 2 * h);
+    if (add_prod)
+        addTo(t, tn, prod, 2 * hh);
+    else
+        subFrom(t, tn, prod, 2 * hh);
+
+    addTrimmed(r + h, rn - h, t, tn);
+}
+
+// r0 = r[0..2k) and r4 = r[4k..4k+r4n) are in place, r[2k..4k) is zero, w1, w_minus1 = |w(-1)|, w2 and t
+// have len = 2k + 2 limbs, negative is sign of w(-1). Restores r1, r2, r3 and adds them into r[0..rn).
+void toom3Interpolate(limb_t *r, size_t rn, size_t k, size_t r4n,
+                      limb_t *w1, limb_t *w_minus1, limb_t *w2, limb_t *t, bool negative) {
+    const size_t len = 2 * k + 2;
+    const limb_t *r0 = r, *r4 = r + 4 * k;
+
+    // w(1) +- w(-1), all intermediate values below are non-negative
+    std::copy(w1, w1 + len, t);
+    addTo(w1, len, w_minus1, len);
+    subFrom(t, len, w_minus1, len);
+    limb_t *sum = (negative ? t : w1), *diff = (negative ? w1 : t);
+
+    // sum = r0 + r2 + r4 -> r2, diff = r1 + r3
+    shiftRight1(sum, len);
+    shiftRight1(diff, len);
+    subFrom(sum, len, r0, 2 * k);
+    subFrom(sum, len, r4, r4n);
+
+    // w2 = r0 + 2r1 + 4r2 + 8r3 + 16r4 -> r1 + 4r3 -> r3
+    subFrom(w2, len, r0, 2 * k);
+    subMulFrom(w2, len, sum, len, 4);
+    subMulFrom(w2, len, r4, r4n, 16);
+    shiftRight1(w2, len);
+    subFrom(w2, len, diff, len);
+    divideBy3(w2, len);
+    subFrom(diff, len, w2, len);
+
+    addTrimmed(r + k, rn - k, diff, len);
+    addTrimmed(r + 2 * k, rn - 2 * k, sum, len);
+    addTrimmed(r + 3 * k, rn - 3 * k, w2, len);
+}
+
+// One product of a Karatsuba/Toom-3 level, squares when both operands are the same
+struct SubProduct {
+    limb_t *r;
+    const limb_t *a;
+    size_t n;
+    const limb_t *b;
+    size_t m;
+
+    void run(limb_t *scratch) const {
+        if (a == b && n == m)
+            sqr(r, a, n, scratch);
+        else
+            mul(r, a, n, b, m, scratch);
+    }
+};
+
+// The products of one level are independent and write to disjoint places. From kParallelMulThreshold limbs on,
+// inside a parallel region, they run as OpenMP tasks with scratch of their own, otherwise one by one on scratch.
+void runSubProducts(std::initializer_list<SubProduct> products, size_t size, limb_t *scratch) {
+    if (size < kParallelMulThreshold || !omp_in_parallel()) {
+        for (const SubProduct &product : products)
+            product.run(scratch);
+        return;
+    }
+    for (SubProduct product : products) {
+        #pragma omp task firstprivate(product)
+        {
+            // runs on the thread that picked up the task, so it gets that thread's workspace
+            Workspace workspace;
+            product.run(workspace.alloc<limb_t>(mulScratchSize(product.n, product.m)));
+        }
+    }
+    #pragma omp taskwait
+}
+
+}
+
+void mulBasecase(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m) {
+    r[n] = mul_1(r, a, n, b[0]);
+    for (size_t i = 1; i < m; i++) {
+        r[i + n] = addmul_1(r + i, a, n, b[i]);
+    }
+}
+
+void mulKaratsuba(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limb_t *scratch) {
+    // a = a1*B^h + a0, b = b1*B^h + b0, requires h < m <= n
+    // a*b = z2*B^2h + (z0 + z2 - (a0 - a1)(b0 - b1))*B^h + z0
+    const size_t h = n / 2, hh = n - h;
+    limb_t *da = scratch, *db = da + hh, *prod = db + hh, *t = prod + 2 * hh, *next = t + 2 * hh + 1;
+
+    bool negative = absDiff(da, a, h, a + h, n - h, hh) != absDiff(db, b, h, b + h, m - h, hh);
+    runSubProducts({{r, a, h, b, h}, {r + 2 * h, a + h, n - h, b + h, m - h}, {prod, da, hh, db, hh}}, m, next);
+
+    karatsubaCombine(r, n + m, h, hh, prod, negative, t);
+}
+
+void mulToom3(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limb_t *scratch) {
+    // splits into 3 parts of k limbs, evaluates at 0, 1, -1, 2, inf, requires 2k < m <= n
+    const size_t k = (n + 2) / 3, n2 = n - 2 * k, m2 = m - 2 * k, len = 2 * k + 2;
+    limb_t *a_at1 = scratch, *a_at_minus1 = a_at1 + k + 1, *a_at2 = a_at_minus1 + k + 1;
+    limb_t *b_at1 = a_at2 + k + 1, *b_at_minus1 = b_at1 + k + 1, *b_at2 = b_at_minus1 + k + 1;
+    limb_t *w1 = b_at2 + k + 1, *w_minus1 = w1 + len, *w2 = w_minus1 + len, *t = w2 + len, *next = t + len;
+
+    bool negative = toom3Evaluate(a, k, n2, a_at1, a_at_minus1, a_at2) !=
+                    toom3Evaluate(b, k, m2, b_at1, b_at_minus1, b_at2);
+
+    // r0 = w(0) and r4 = w(inf) go straight to their places
+    std::fill(r + 2 * k, r + 4 * k, 0);
+    runSubProducts({{r, a, k, b, k}, {r + 4 * k, a + 2 * k, n2, b + 2 * k, m2},
+                    {w1, a_at1, k + 1, b_at1, k + 1},
+                    {w_minus1, a_at_minus1, k + 1, b_at_minus1, k + 1},
+                    {w2, a_at2, k + 1, b_at2, k + 1}}, m, next);
+
+    toom3Interpolate(r, n + m, k, n2 + m2, w1, w_minus1, w2, t, negative);
+}
+
+void mul(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limb_t *scratch) {
+    if (m >= kParallelMulThreshold && canStartParallel()) {
+        #pragma omp parallel
+        #pragma omp single
+        mul(r, a, n, b, m, scratch);
+        return;
+    }
+    if (m < kKaratsubaThreshold)
+        mulBasecase(r, a, n, b, m);
+    else if (m >= kNttThreshold && n + m <= kNttMaxLimbs)
+        mulNtt(r, a, n, b, m);
+    else if (2 * m <= n)
+        mulUnbalanced(r, a, n, b, m, scratch);
+    else if (m >= kToom3Threshold && m > 2 * ((n + 2) / 3))
+        mulToom3(r, a, n, b, m, scratch);
+    else
+        mulKaratsuba(r, a, n, b, m, scratch);
+}
+
+void sqrBasecase(limb_t *r, const limb_t *a, size_t n) {
+    // cross products a[i]*a[j], i < j, are computed once and doubled
+    r[0] = r[2 * n - 1] = 0;
+    if (n > 1) {
+        r[n] = mul_1(r + 1, a + 1, n - 1, a[0]);
+        for (size_t i = 1; i + 1 < n; i++) {
+            r[i + n] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        }
+    }
+    add_n(r, r, r, 2 * n);
+
+    limb_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        limb_ll sq = limb_ll(a[i]) * a[i];
+        limb_ll cur = limb_ll(r[2 * i]) + limb_t(sq) + carry;
+        r[2 * i] = limb_t(cur);
+        cur = limb_ll(r[2 * i + 1]) + limb_t(sq >> kBits) + limb_t(cur >> kBits);
+        r[2 * i + 1] = limb_t(cur);
+        carry = limb_t(cur >> kBits);
+    }
+}
+
+void sqrKaratsuba(limb_t *r, const limb_t *a, size_t n, limb_t *scratch) {
+    // a^2 = z2*B^2h + (z0 + z2 - (a0 - a1)^2)*B^h + z0
+    const size_t h = n / 2, hh = n - h;
+    limb_t *da = scratch, *prod = da + hh, *t = prod + 2 * hh, *next = t + 2 * hh + 1;
+
+    absDiff(da, a, h, a + h, hh, hh);
+    runSubProducts({{r, a, h, a, h}, {r + 2 * h, a + h, hh, a + h, hh}, {prod, da, hh, da, hh}}, n, next);
+
+    karatsubaCombine(r, 2 * n, h, hh, prod, false, t);
+}
+
+void sqrToom3(limb_t *r, const limb_t *a, size_t n, limb_t *scratch) {
+    const size_t k = (n + 2) / 3, n2 = n - 2 * k, len = 2 * k + 2;
+    limb_t *a_at1 = scratch, *a_at_minus1 = a_at1 + k + 1, *a_at2 = a_at_minus1 + k + 1;
+    limb_t *w1 = a_at2 + k + 1, *w_minus1 = w1 + len, *w2 = w_minus1 + len, *t = w2 + len, *next = t + len;
+
+    toom3Evaluate(a, k, n2, a_at1, a_at_minus1, a_at2);
+
+    std::fill(r + 2 * k, r + 4 * k, 0);
+    runSubProducts({{r, a, k, a, k}, {r + 4 * k, a + 2 * k, n2, a + 2 * k, n2},
+                    {w1, a_at1, k + 1, a_at1, k + 1},
+                    {w_minus1, a_at_minus1, k + 1, a_at_minus1, k + 1},
+                    {w2, a_at2, k + 1, a_at2, k + 1}}, n, next);
+
+    toom3Interpolate(r, 2 * n, k, 2 * n2, w1, w_minus1, w2, t, false);
+}
+
+void sqr(limb_t *r, const limb_t *a, size_t n, limb_t *scratch) {
+    if (n >= kParallelMulThreshold && canStartParallel()) {
+        #pragma omp parallel
+        #pragma omp single
+        sqr(r, a, n, scratch);
+        return;
+    }
+    if (n < kSqrKaratsubaThreshold)
+        sqrBasecase(r, a, n);
+    else if (n >= kNttThreshold && 2 * n <= kNttMaxLimbs)
+        mulNtt(r, a, n, a, n);
+    else if (n >= kSqrToom3Threshold)
+        sqrToom3(r, a, n, scratch);
+    else
+        sqrKaratsuba(r, a, n, scratch);
+}
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <BigInt/BigUint.h>
+
+// Routines on raw little-endian limb arrays, used as building blocks by BigUint
+namespace limbs {
+
+// Sizes (in limbs of the shorter operand) above which faster multiplication/squaring is used,
+// see BigIntMulBenchmark and BigIntNttBenchmark in ArithmeticTests for tuning
+constexpr size_t kKaratsubaThreshold = 32;
+constexpr size_t kToom3Threshold = 160;
+constexpr size_t kNttThreshold = 8192;
+constexpr size_t kSqrKaratsubaThreshold = 48;
+constexpr size_t kSqrToom3Threshold = 192;
+
+// NTT primes allow transforms up to 2^24 32-bit pieces, i.e. n + m <= 2^23 limbs
+constexpr size_t kNttMaxLimbs = size_t(1) << 23;
+
+// Transform length from which the three NTT primes and the halves of each transform run as OpenMP tasks
+constexpr size_t kNttParallelThreshold = size_t(1) << 16;
+
+// Size (limbs of the shorter operand) from which Karatsuba/Toom-3 levels run their sub-products as OpenMP tasks.
+// Below it everything stays on the calling thread.
+constexpr size_t kParallelMulThreshold = 1024;
+
+// Divisor and quotient size (limbs) from which division multiplies by a Newton reciprocal instead of Knuth's
+// algorithm, see BigIntDivBenchmark in ArithmeticTests
+constexpr size_t kDivNewtonThreshold = 1500;
+
+// True if no OpenMP team is active and more than one thread is available, i.e. a caller with enough work
+// should open a parallel region so that the tasks it creates spread over the cores
+bool canStartParallel();
+
+// Primitives on n-limb arrays (LimbKernels.cpp), r may be equal to a or b.
+// Dispatch to MULX/ADCX/ADOX versions on CPUs that support them.
+
+// r = a + b, returns carry
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+// r = a - b, returns borrow
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+// r = a * v, returns the high limb
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+
+// r += a * v, returns the carry limb
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+
+// r -= a * v, returns the borrow limb
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+
+// Both implementations are exposed for tests and benchmarks
+namespace portable {
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+}
+
+namespace adx {
+// false on other CPUs and platforms, the functions below must not be called then
+bool supported();
+limb_t add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+limb_t sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+limb_t mul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+limb_t addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+limb_t submul_1(limb_t *r, const limb_t *a, size_t n, limb_t v);
+}
+
+// x[0..xn) += y[0..yn), yn <= xn, returns carry out of x
+limb_t addTo(limb_t *x, size_t xn, const limb_t *y, size_t yn);
+
+// x[0..xn) -= y[0..yn), yn <= xn, returns borrow out of x
+limb_t subFrom(limb_t *x, size_t xn, const limb_t *y, size_t yn);
+
+// x[0..xn) += y[0..yn) * v, yn <= xn, returns carry out of x
+limb_t addMulTo(limb_t *x, size_t xn, const limb_t *y, size_t yn, limb_t v);
+
+// x[0..xn) -= y[0..yn) * v, yn <= xn, returns borrow out of x
+limb_t subMulFrom(limb_t *x, size_t xn, const limb_t *y, size_t yn, limb_t v);
+
+int compare(const limb_t *x, size_t xn, const limb_t *y, size_t yn);
+
+// q[0..n) = a[0..n) / v, returns the remainder, v != 0, q may be equal to a or null.
+// Uses a precomputed reciprocal of v instead of a hardware division per limb.
+limb_t divWord(limb_t *q, const limb_t *a, size_t n, limb_t v);
+
+// dst = src << shift, 0 <= shift < limb bits, dst may be equal to src
+void shiftLeft(limb_t *dst, const limb_t *src, size_t n, int shift);
+
+// dst = src >> shift, 0 <= shift < limb bits, dst may be equal to src
+void shiftRight(limb_t *dst, const limb_t *src, size_t n, int shift);
+
+// u has m + n + 1 limbs with u[m+1..m+n+1) < v, v has n >= 2 limbs with the top bit of v[n - 1] set.
+// Leaves the remainder in u[0..n), writes m + 1 quotient limbs to q unless it is null.
+// Picks Knuth's algorithm or Newton division by size.
+void divideNormalized(limb_t *u, size_t m, const limb_t *v, size_t n, limb_t *q);
+
+// Knuth, TAOCP Vol. 2, 4.3.1, Algorithm D, same contract as divideNormalized
+void divideKnuth(limb_t *u, size_t m, const limb_t *v, size_t n, limb_t *q);
+
+// Same contract as divideNormalized. Produces the quotient in blocks of n limbs, each from a product with
+// the reciprocal of v and fixed up by at most a few subtractions, so it runs at the speed (and on the threads) of mul.
+void divideNewton(limb_t *u, size_t m, const limb_t *v, size_t n, limb_t *q);
+
+// x[0..n] = floor((B^2n - 1) / v[0..n)), v normalized, n >= 2.
+// Newton iteration from the reciprocal of the top half of v.
+void reciprocal(limb_t *x, const limb_t *v, size_t n);
+
+// q[0..n-m+1) = a[0..n) / d[0..m), r[0..m) = a[0..n) % d[0..m), requires n >= m and d[m - 1] != 0.
+// q may be null, scratch holds n + m + 1 limbs, none of the outputs may overlap a or d.
+void divRem(limb_t *q, limb_t *r, const limb_t *a, size_t n, const limb_t *d, size_t m, limb_t *scratch);
+
+// Limbs needed by mul(r, a, n, b, m, scratch), constexpr so fixed-width callers can use a stack array.
+// Covers the largest level of every algorithm, sub-products are at most ceil(n/2) long.
+constexpr size_t mulScratchSize(size_t n, size_t m) {
+    return m < kKaratsubaThreshold ? 0 : 5 * n + 32 + mulScratchSize((n + 1) / 2, (n + 1) / 2);
+}
+
+// r[0..n+m) = a[0..n) * b[0..m), n >= m >= 1, r must not overlap inputs or scratch.
+// Picks schoolbook, Karatsuba, Toom-3 or NTT by size, recursion uses scratch only
+// except for parallel levels, whose tasks take theirs from a Workspace.
+void mul(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limb_t *scratch);
+
+// Single levels of each algorithm (sub-products go through mul), exposed for benchmarks
+void mulBasecase(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m);
+
+void mulKaratsuba(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limb_t *scratch);
+
+void mulToom3(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m, limb_t *scratch);
+
+// Three-prime NTT with CRT recombination, requires n + m <= kNttMaxLimbs, needs no scratch.
+// Transforms a only once if b is the same array.
+void mulNtt(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m);
+
+// r[0..2n) = a[0..n)^2, computes every cross product once, scratch of mulScratchSize(n, n) limbs
+void sqr(limb_t *r, const limb_t *a, size_t n, limb_t *scratch);
+
+void sqrBasecase(limb_t *r, const limb_t *a, size_t n);
+
+void sqrKaratsuba(limb_t *r, const limb_t *a, size_t n, limb_t *scratch);
+
+void sqrToom3(limb_t *r, const limb_t *a, size_t n, limb_t *scratch);
+
+}
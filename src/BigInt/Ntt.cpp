@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <bit>
+#include <vector>
+#include <omp.h>
+#include "Limbs.h"
+
+// Multiplication by number-theoretic transform over three ~30-bit primes.
+// Limbs are split into 32-bit pieces, each piece convolution value is below 2^23 * 2^64 < p1*p2*p3,
+// so the exact value is restored by CRT.
+namespace limbs {
+
+namespace {
+
+// Smallest (sub-)transform that is split into tasks in parallel mode
+constexpr size_t kNttTaskLength = size_t(1) << 14;
+
+constexpr uint32_t powMod32(uint64_t base, uint64_t power, uint32_t mod) {
+    uint64_t res = 1;
+    base %= mod;
+    while (power > 0) {
+        if (power & 1)
+            res = res * base % mod;
+        base = base * base % mod;
+        power >>= 1;
+    }
+    return uint32_t(res);
+}
+
+template<uint32_t Mod, uint32_t Root>
+struct NttPrime {
+    static constexpr uint32_t mod = Mod;
+
+    // Montgomery arithmetic with R = 2^32, mod < 2^31 keeps every sum below 2^64
+    static constexpr uint32_t mod_neg_inv = [] {
+        uint32_t inv = Mod;
+        for (int i = 0; i < 5; i++)
+            inv *= 2 - Mod * inv;
+        return -inv;
+    }();
+    static constexpr uint32_t r2 = uint32_t((uint64_t(1) << 32) % Mod * ((uint64_t(1) << 32) % Mod) % Mod);
+
+    static uint32_t reduce(uint64_t t) {
+        uint32_t m = uint32_t(t) * mod_neg_inv;
+        uint32_t u = uint32_t((t + uint64_t(m) * Mod) >> 32);
+        return std::min(u, u - Mod);
+    }
+
+    // a * b / R mod Mod
+    static uint32_t mul(uint32_t a, uint32_t b) {
+        return reduce(uint64_t(a) * b);
+    }
+
+    static uint32_t toMontgomery(uint32_t a) {
+        return uint32_t((uint64_t(a) << 32) % Mod);
+    }
+
+    // roots[half + j] = w^j for w of order 2 * half, for every half < len, in Montgomery form
+    static std::vector<uint32_t> computeRoots(size_t len, bool inverse) {
+        std::vector<uint32_t> roots(std::max<size_t>(len, 2));
+        for (size_t half = 1; half < len; half <<= 1) {
+            uint32_t w = powMod32(Root, (Mod - 1) / (2 * half), Mod);
+            if (inverse)
+                w = powMod32(w, Mod - 2, Mod);
+            const uint32_t w_mont = toMontgomery(w);
+            roots[half] = toMontgomery(1);
+            for (size_t j = 1; j < half; j++)
+                roots[half + j] = mul(roots[half + j - 1], w_mont);
+        }
+        return roots;
+    }
+
+    // branch-free: the wrapped-around candidate is always the larger one
+    static uint32_t add(uint32_t a, uint32_t b) {
+        return std::min(a + b, a + b - Mod);
+    }
+
+    static uint32_t sub(uint32_t a, uint32_t b) {
+        return std::min(a - b, a - b + Mod);
+    }
+
+    // Decimation in frequency, natural order in, bit-reversed order out.
+    // In parallel mode the halves left after each top stage are transformed as separate tasks.
+    static void forward(uint32_t *a, size_t len, const uint32_t *roots, bool parallel) {
+        if (parallel && len >= kNttTaskLength) {
+            const size_t half = len / 2;
+            const uint32_t *w = roots + half;
+            for (size_t j = 0; j < half; j++) {
+                uint32_t u = a[j], v = a[j + half];
+                a[j] = add(u, v);
+                a[j + half] = mul(sub(u, v), w[j]);
+            }
+            #pragma omp task
+            forward(a, half, roots, true);
+            #pragma omp task
+            forward(a + half, half, roots, true);
+            #pragma omp taskwait
+            return;
+        }
+        for (size_t half = len / 2; half >= 1; half >>= 1) {
+            const uint32_t *w = roots + half;
+            for (size_t i = 0; i < len; i += 2 * half) {
+                uint32_t *lo = a + i, *hi = a + i + half;
+                for (size_t j = 0; j < half; j++) {
+                    uint32_t u = lo[j], v = hi[j];
+                    lo[j] = add(u, v);
+                    hi[j] = mul(sub(u, v), w[j]);
+                }
+            }
+        }
+    }
+
+    // Decimation in time, bit-reversed order in, natural order out (unscaled)
+    static void inverse(uint32_t *a, size_t len, const uint32_t *roots, bool parallel) {
+        if (parallel && len >= kNttTaskLength) {
+            const size_t half = len / 2;
+            #pragma omp task
+            inverse(a, half, roots, true);
+            #pragma omp task
+            inverse(a + half, half, roots, true);
+            #pragma omp taskwait
+            const uint32_t *w = roots + half;
+            for (size_t j = 0; j < half; j++) {
+                uint32_t u = a[j], v = mul(a[j + half], w[j]);
+                a[j] = add(u, v);
+                a[j + half] = sub(u, v);
+            }
+            return;
+        }
+        for (size_t half = 1; half < len; half <<= 1) {
+            const uint32_t *w = roots + half;
+            for (size_t i = 0; i < len; i += 2 * half) {
+                uint32_t *lo = a + i, *hi = a + i + half;
+                for (size_t j = 0; j < half; j++) {
+                    uint32_t u = lo[j], v = mul(hi[j], w[j]);
+                    lo[j] = add(u, v);
+                    hi[j] = sub(u, v);
+                }
+            }
+        }
+    }
+
+    static void toPieces(uint32_t *out, const limb_t *a, size_t n, size_t len) {
+        for (size_t i = 0; i < n; i++) {
+            out[2 * i] = uint32_t(a[i]) % Mod;
+            out[2 * i + 1] = uint32_t(a[i] >> 32) % Mod;
+        }
+        std::fill(out + 2 * n, out + len, 0);
+    }
+
+    // cyclic convolution of 32-bit pieces of a and b modulo Mod, squaring needs one forward transform
+    static std::vector<uint32_t> convolve(const limb_t *a, size_t n, const limb_t *b, size_t m, size_t len,
+                                          bool parallel) {
+        const bool square = (a == b && n == m);
+        std::vector<uint32_t> fa(len), fb(square ? 0 : len);
+        auto roots = computeRoots(len, false);
+        #pragma omp task if(parallel) shared(fa, roots)
+        {
+            toPieces(fa.data(), a, n, len);
+            forward(fa.data(), len, roots.data(), parallel);
+        }
+        if (!square) {
+            toPieces(fb.data(), b, m, len);
+            forward(fb.data(), len, roots.data(), parallel);
+        }
+        #pragma omp taskwait
+        const uint32_t *other = (square ? fa.data() : fb.data());
+        // pointwise products come out divided by R, scale by R^2 / len to restore them
+        for (size_t i = 0; i < len; i++)
+            fa[i] = mul(fa[i], other[i]);
+        roots = computeRoots(len, true);
+        inverse(fa.data(), len, roots.data(), parallel);
+        const uint32_t scale = uint32_t(uint64_t(r2) * powMod32(len % Mod, Mod - 2, Mod) % Mod);
+        for (size_t i = 0; i < len; i++)
+            fa[i] = mul(fa[i], scale);
+        return fa;
+    }
+};
+
+using Prime1 = NttPrime<469762049, 3>;    // 7 * 2^26 + 1
+using Prime2 = NttPrime<754974721, 11>;   // 45 * 2^24 + 1
+using Prime3 = NttPrime<2013265921, 31>;  // 15 * 2^27 + 1
+
+// Garner's algorithm, x = x1 + p1*x2 + p1*p2*x3
+limb_ll crt(uint32_t r1, uint32_t r2, uint32_t r3) {
+    constexpr uint32_t p1 = Prime1::mod, p2 = Prime2::mod, p3 = Prime3::mod;
+    constexpr uint32_t p1_inv_p2 = powMod32(p1, p2 - 2, p2);
+    constexpr uint32_t p1_inv_p3 = powMod32(p1, p3 - 2, p3);
+    constexpr uint32_t p2_inv_p3 = powMod32(p2, p3 - 2, p3);
+
+    uint64_t x1 = r1;
+    uint64_t x2 = (r2 + p2 - x1 % p2) % p2 * p1_inv_p2 % p2;
+    uint64_t t = (r3 + p3 - x1 % p3) % p3 * p1_inv_p3 % p3;
+    uint64_t x3 = (t + p3 - x2 % p3) % p3 * p2_inv_p3 % p3;
+    return x1 + limb_ll(p1) * x2 + limb_ll(uint64_t(p1) * p2) * x3;
+}
+
+}
+
+void mulNtt(limb_t *r, const limb_t *a, size_t n, const limb_t *b, size_t m) {
+    const size_t pieces = 2 * (n + m), len = std::bit_ceil(pieces);
+    if (len >= kNttParallelThreshold && canStartParallel()) {
+        #pragma omp parallel
+        #pragma omp single
+        mulNtt(r, a, n, b, m);
+        return;
+    }
+    const bool parallel = (len >= kNttParallelThreshold && omp_in_parallel());
+
+    std::vector<uint32_t> res[3];
+    #pragma omp task if(parallel) shared(res)
+    res[0] = Prime1::convolve(a, n, b, m, len, parallel);
+    #pragma omp task if(parallel) shared(res)
+    res[1] = Prime2::convolve(a, n, b, m, len, parallel);
+    res[2] = Prime3::convolve(a, n, b, m, len, parallel);
+    #pragma omp taskwait
+
+    std::vector<limb_ll> values(pieces);
+    #pragma omp taskloop if(parallel) grainsize(kNttTaskLength) shared(values, res)
+    for (size_t i = 0; i < pieces; i++)
+        values[i] = crt(res[0][i], res[1][i], res[2][i]);
+
+    limb_ll carry = 0;
+    for (size_t i = 0; i < n + m; i++) {
+        carry += values[2 * i];
+        limb_t lo = limb_t(carry) & 0xffffffffu;
+        carry >>= 32;
+        carry += values[2 * i + 1];
+        r[i] = lo | (limb_t(carry) << 32);
+        carry >>= 32;
+    }
+}
+
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+
+// Plain new[]/delete[], the default storage of SmallVector
+template<typename T>
+struct HeapAllocator {
+    static T *allocate(size_t n) {
+        return new T[n];
+    }
+
+    static void deallocate(T *ptr, size_t) {
+        delete[] ptr;
+    }
+};
+
+// Vector of trivially copyable values that keeps up to InlineCapacity elements inside the object
+// and moves to Alloc only when it grows beyond that. Interface follows std::vector.
+// Alloc provides static allocate(n) and deallocate(ptr, n).
+template<typename T, size_t InlineCapacity, typename Alloc = HeapAllocator<T>>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector copies elements with memcpy");
+    static_assert(InlineCapacity > 0);
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SmallVector() = default;
+
+    explicit SmallVector(size_t count, const T &value = T()) {
+        assign(count, value);
+    }
+
+    SmallVector(std::initializer_list<T> values) {
+        reserve(values.size());
+        std::copy(values.begin(), values.end(), _data);
+        _size = values.size();
+    }
+
+    SmallVector(const SmallVector &other) {
+        reserve(other._size);
+        std::memcpy(_data, other._data, other._size * sizeof(T));
+        _size = other._size;
+    }
+
+    // steals a heap buffer, inline elements are copied
+    SmallVector(SmallVector &&other) noexcept {
+        moveFrom(other);
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) {
+            _size = 0;
+            reserve(other._size);
+            std::memcpy(_data, other._data, other._size * sizeof(T));
+            _size = other._size;
+        }
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept {
+        if (this != &other) {
+            release();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        release();
+    }
+
+    T *data() { return _data; }
+    const T *data() const { return _data; }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+
+    // true while no allocated memory is owned
+    bool isInline() const { return _data == _inline; }
+
+    T &operator[](size_t i) { return _data[i]; }
+    const T &operator[](size_t i) const { return _data[i]; }
+
+    T &front() { return _data[0]; }
+    const T &front() const { return _data[0]; }
+    T &back() { return _data[_size - 1]; }
+    const T &back() const { return _data[_size - 1]; }
+
+    iterator begin() { return _data; }
+    const_iterator begin() const { return _data; }
+    iterator end() { return _data + _size; }
+    const_iterator end() const { return _data + _size; }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity <= _capacity)
+            return;
+        T *buffer = Alloc::allocate(new_capacity);
+        std::memcpy(buffer, _data, _size * sizeof(T));
+        release();
+        _data = buffer;
+        _capacity = new_capacity;
+    }
+
+    // new elements are set to value, as in std::vector
+    void resize(size_t new_size, const T &value = T()) {
+        if (new_size > _capacity)
+            reserve(std::max(new_size, 2 * _capacity));
+        if (new_size > _size)
+            std::fill(_data + _size, _data + new_size, value);
+        _size = new_size;
+    }
+
+    void assign(size_t count, const T &value) {
+        _size = 0;
+        resize(count, value);
+    }
+
+    void push_back(const T &value) {
+        if (_size == _capacity) {
+            T copy = value; // value may live in the buffer being reallocated
+            reserve(2 * _capacity);
+            _data[_size++] = copy;
+        } else {
+            _data[_size++] = value;
+        }
+    }
+
+    void pop_back() {
+        _size--;
+    }
+
+    void clear() {
+        _size = 0;
+    }
+
+    friend bool operator==(const SmallVector &lhs, const SmallVector &rhs) {
+        return lhs._size == rhs._size && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+private:
+    void release() {
+        if (!isInline())
+            Alloc::deallocate(_data, _capacity);
+        _data = _inline;
+        _capacity = InlineCapacity;
+    }
+
+    // *this must not own heap memory
+    void moveFrom(SmallVector &other) {
+        if (other.isInline()) {
+            std::memcpy(_inline, other._inline, other._size * sizeof(T));
+        } else {
+            _data = other._data;
+            _capacity = other._capacity;
+            other._data = other._inline;
+            other._capacity = InlineCapacity;
+        }
+        _size = other._size;
+        other._size = 0;
+    }
+
+    T *_data = _inline;
+    size_t _size = 0;
+    size_t _capacity = InlineCapacity;
+    T _inline[InlineCapacity];
+};
@@ -26,12 +26,11 @@ public:
     };
 
     BigInt GenRandomPrime(size_t bit_key_size){
-        std::uniform_int_distribution<int> distribution(0, 1);
-        BigInt num = 0;
-        for(size_t i = 0; i < bit_key_size; i++) {
-            auto random = static_cast<int>(distribution(rng));
-            num = num * 2 + BigInt{random};
-        }
+        std::vector<uint8_t> bytes((bit_key_size + 7) / 8);
+        for(auto &byte : bytes)
+            byte = static_cast<uint8_t>(rng());
+        BigInt num = BigInt::fromBytes(bytes.data(), bytes.size());
+        num >>= bytes.size() * 8 - bit_key_size;
         return math::GenNextPrime(num);
     }
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Aes/Aes.h>
+#include <AES/Aes.h>
 #include <optional>
 
 namespace algo::stream {
@@ -0,0 +1,82 @@
+#include "Cipher.h"
+#include <chrono>
+
+namespace algo::stream {
+
+static_assert(BlockCipher<AesBlock>);
+static_assert(StreamCipher<rc4::Context>);
+
+namespace {
+
+template<MessageCipher T>
+void RegisterAesMode(CipherRegistry &registry, std::string_view mode_name) {
+    for(size_t key_size : {128, 192, 256}) {
+        registry.Register<T>("aes-" + std::to_string(key_size) + "-" + std::string(mode_name), key_size / 8);
+    }
+}
+
+CipherRegistry CreateDefaultRegistry() {
+    CipherRegistry registry;
+    RegisterAesMode<EcbCipher<AesBlock>>(registry, "ecb");
+    RegisterAesMode<AesModeCipher<CipherMode::kCbc>>(registry, "cbc");
+    RegisterAesMode<AesModeCipher<CipherMode::kCfb>>(registry, "cfb");
+    RegisterAesMode<AesModeCipher<CipherMode::kOfb>>(registry, "ofb");
+    RegisterAesMode<AesModeCipher<CipherMode::kCtr>>(registry, "ctr");
+    registry.Register<Rc4Cipher>("rc4", 0);
+    registry.Register<Salsa20Cipher>("salsa20", 32);
+    return registry;
+}
+
+}
+
+CipherRegistry &CipherRegistry::Instance() {
+    static CipherRegistry registry = CreateDefaultRegistry();
+    return registry;
+}
+
+void CipherRegistry::Register(const std::string &name, size_t key_size, Factory factory) {
+    _entries[name] = Entry{key_size, std::move(factory)};
+}
+
+const CipherRegistry::Entry &CipherRegistry::Find(std::string_view name) const {
+    auto it = _entries.find(name);
+    if(it == _entries.end()) {
+        throw std::invalid_argument("Unknown cipher " + std::string(name));
+    }
+    return it->second;
+}
+
+std::unique_ptr<Cipher> CipherRegistry::Create(std::string_view name, const std::vector<uint8_t> &key) const {
+    const auto &entry = Find(name);
+    if(entry.key_size != 0 && entry.key_size != key.size()) {
+        throw std::logic_error("Invalid key size " + std::to_string(key.size() * 8) + " for " + std::string(name));
+    }
+    return entry.factory(key);
+}
+
+size_t CipherRegistry::GetKeySize(std::string_view name) const {
+    return Find(name).key_size;
+}
+
+std::vector<std::string> CipherRegistry::GetNames() const {
+    std::vector<std::string> names;
+    for(const auto &it : _entries) {
+        names.push_back(it.first);
+    }
+    return names;
+}
+
+double BenchmarkCipher(Cipher &cipher, size_t size) {
+    std::vector<uint8_t> data(size);
+    for(size_t i = 0; i < data.size(); i++) {
+        data[i] = i; // pseudo random data
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    cipher.Encrypt(data);
+    cipher.Decrypt(data);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t2 - t1).count();
+}
+
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <StreamCiphers/Aes.h>
+#include <StreamCiphers/StreamCiphers.h>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace algo::stream {
+
+// Encrypts/decrypts single fixed-size blocks in place or out of place
+template<typename T>
+concept BlockCipher = requires(T &cipher, const uint8_t *in, uint8_t *out) {
+    { T::kBlockSize } -> std::convertible_to<size_t>;
+    cipher.EncryptBlock(in, out);
+    cipher.DecryptBlock(in, out);
+};
+
+// Xors next len bytes of keystream into out, keeps position between calls
+template<typename T>
+concept StreamCipher = requires(T &cipher, const uint8_t *in, size_t len, uint8_t *out) {
+    cipher.Apply(in, len, out);
+};
+
+// Transforms whole message in place, IV/nonce (if any) is stored in front of the data
+template<typename T>
+concept MessageCipher = requires(T &cipher, std::vector<uint8_t> &data) {
+    cipher.Encrypt(data);
+    cipher.Decrypt(data);
+};
+
+class AesBlock {
+public:
+    static constexpr size_t kBlockSize = Aes::BlockSize;
+
+    AesBlock(const std::vector<uint8_t> &key) : _aes(key.size() * 8), _expanded_key(_aes.ExpandedKeySize) {
+        _aes.KeyExpansion(key.data(), _expanded_key.data());
+    }
+
+    void EncryptBlock(const uint8_t *in, uint8_t *out) {
+        _aes.Cipher(in, out, _expanded_key.data());
+    }
+
+    void DecryptBlock(const uint8_t *in, uint8_t *out) {
+        _aes.InvCipher(in, out, _expanded_key.data());
+    }
+
+private:
+    Aes _aes;
+    std::vector<uint8_t> _expanded_key;
+};
+
+// len must be a multiple of the block size
+template<BlockCipher B>
+void CheckBlockLength(size_t len) {
+    if(len % B::kBlockSize != 0) {
+        throw std::invalid_argument("Data size " + std::to_string(len) + " is not a multiple of the block size");
+    }
+}
+
+template<BlockCipher B>
+void EncryptBlocks(B &cipher, uint8_t *data, size_t len) {
+    CheckBlockLength<B>(len);
+    for(size_t i = 0; i + B::kBlockSize <= len; i += B::kBlockSize) {
+        cipher.EncryptBlock(data + i, data + i);
+    }
+}
+
+template<BlockCipher B>
+void DecryptBlocks(B &cipher, uint8_t *data, size_t len) {
+    CheckBlockLength<B>(len);
+    for(size_t i = 0; i + B::kBlockSize <= len; i += B::kBlockSize) {
+        cipher.DecryptBlock(data + i, data + i);
+    }
+}
+
+// ECB over any block cipher, throws std::invalid_argument unless the data size is a multiple of the block size
+template<BlockCipher B>
+class EcbCipher {
+public:
+    template<typename... Args>
+    EcbCipher(Args &&... args) : _cipher(std::forward<Args>(args)...) {}
+
+    void Encrypt(std::vector<uint8_t> &data) { EncryptBlocks(_cipher, data.data(), data.size()); }
+    void Decrypt(std::vector<uint8_t> &data) { DecryptBlocks(_cipher, data.data(), data.size()); }
+
+private:
+    B _cipher;
+};
+
+// PKCS#7: appends 1..block_size bytes, each equal to their count
+inline void AddPkcs7Padding(std::vector<uint8_t> &data, size_t block_size) {
+    const size_t padding = block_size - data.size() % block_size;
+    data.insert(data.end(), padding, static_cast<uint8_t>(padding));
+}
+
+// Throws std::invalid_argument if data does not end with valid PKCS#7 padding
+inline void RemovePkcs7Padding(std::vector<uint8_t> &data, size_t block_size) {
+    const size_t padding = data.empty() ? 0 : data.back();
+    if(padding == 0 || padding > block_size || padding > data.size() ||
+       std::any_of(data.end() - padding, data.end(), [padding](uint8_t byte) { return byte != padding; })) {
+        throw std::invalid_argument("Invalid PKCS#7 padding");
+    }
+    data.resize(data.size() - padding);
+}
+
+// Existing AES Stream with the mode fixed at compile time. Stream writes whole blocks after a one-block IV
+// in every mode, so messages are padded with PKCS#7 and Decrypt accepts only the IV plus whole blocks.
+template<CipherMode Mode>
+class AesModeCipher {
+public:
+    static constexpr size_t kBlockSize = AesBlock::kBlockSize;
+
+    AesModeCipher(const std::vector<uint8_t> &key) : _key(key), _stream(_key) {}
+    AesModeCipher(const AesModeCipher &) = delete; // _stream refers to _key
+
+    void Encrypt(std::vector<uint8_t> &data) {
+        AddPkcs7Padding(data, kBlockSize);
+        _stream.Encrypt(Mode, data);
+    }
+
+    void Decrypt(std::vector<uint8_t> &data) {
+        if(data.size() < 2 * kBlockSize || data.size() % kBlockSize != 0) {
+            throw std::invalid_argument("Invalid AES ciphertext size " + std::to_string(data.size()));
+        }
+        _stream.Decrypt(Mode, data);
+        RemovePkcs7Padding(data, kBlockSize);
+    }
+
+private:
+    std::vector<uint8_t> _key;
+    Stream _stream;
+};
+
+// Keys each message with the key followed by a random nonce, stored in the first 16 bytes,
+// and drops the start of the keystream, which leaks the most about related keys
+class Rc4Cipher {
+public:
+    static constexpr size_t kNonceSize = 16;
+    static constexpr size_t kDrop = 3072;
+
+    Rc4Cipher(const std::vector<uint8_t> &key) : _key(key) {
+        // rc4 reads at most 256 key bytes, the nonce must fit in after the key
+        if(key.empty() || key.size() > rc4::Context::kStateSize - kNonceSize) {
+            throw std::logic_error("Invalid key size " + std::to_string(key.size() * 8));
+        }
+    }
+
+    void Encrypt(std::vector<uint8_t> &data) {
+        const auto nonce = utils::GenerateRandomVec<uint8_t>(kNonceSize);
+        Apply(nonce.data(), data.data(), data.size());
+        data.insert(data.begin(), nonce.begin(), nonce.end());
+    }
+
+    void Decrypt(std::vector<uint8_t> &data) {
+        if(data.size() < kNonceSize) {
+            throw std::invalid_argument("RC4 ciphertext is shorter than its nonce");
+        }
+        Apply(data.data(), data.data() + kNonceSize, data.size() - kNonceSize);
+        data.erase(data.begin(), data.begin() + kNonceSize);
+    }
+
+private:
+    void Apply(const uint8_t *nonce, uint8_t *text, size_t len) const {
+        std::vector<uint8_t> message_key = _key;
+        message_key.insert(message_key.end(), nonce, nonce + kNonceSize);
+        rc4::Context context(message_key.data(), message_key.size(), kDrop);
+        context.Apply(text, len, text);
+    }
+
+    std::vector<uint8_t> _key;
+};
+
+// Random nonce is stored in the first 8 bytes
+class Salsa20Cipher {
+public:
+    static constexpr size_t kNonceSize = sizeof(uint64_t);
+
+    Salsa20Cipher(const std::vector<uint8_t> &key) : _key(key) {
+        // salsa20::apply takes a 256-bit key as eight little-endian words
+        if(key.size() != 32) {
+            throw std::logic_error("Invalid key size " + std::to_string(key.size() * 8));
+        }
+    }
+
+    void Encrypt(std::vector<uint8_t> &data) {
+        auto nonce_vec = utils::GenerateRandomVec<uint8_t>(kNonceSize);
+        uint64_t nonce;
+        memcpy(&nonce, nonce_vec.data(), kNonceSize);
+        salsa20::apply(data.data(), data.size(), _key.data(), nonce, data.data());
+        data.insert(data.begin(), nonce_vec.begin(), nonce_vec.end());
+    }
+
+    void Decrypt(std::vector<uint8_t> &data) {
+        if(data.size() < kNonceSize) {
+            throw std::invalid_argument("Salsa20 ciphertext is shorter than its nonce");
+        }
+        uint64_t nonce;
+        memcpy(&nonce, data.data(), kNonceSize);
+        data.erase(data.begin(), data.begin() + kNonceSize);
+        salsa20::apply(data.data(), data.size(), _key.data(), nonce, data.data());
+    }
+
+private:
+    std::vector<uint8_t> _key;
+};
+
+// Type-erased cipher, virtual dispatch happens once per message,
+// block/byte loops are instantiated with the concrete type.
+class Cipher {
+public:
+    virtual ~Cipher() = default;
+
+    virtual void Encrypt(std::vector<uint8_t> &data) = 0;
+    virtual void Decrypt(std::vector<uint8_t> &data) = 0;
+};
+
+template<MessageCipher T>
+class CipherImpl final : public Cipher {
+public:
+    template<typename... Args>
+    CipherImpl(Args &&... args) : _impl(std::forward<Args>(args)...) {}
+
+    void Encrypt(std::vector<uint8_t> &data) override { _impl.Encrypt(data); }
+    void Decrypt(std::vector<uint8_t> &data) override { _impl.Decrypt(data); }
+
+private:
+    T _impl;
+};
+
+class CipherRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<Cipher>(const std::vector<uint8_t> &key)>;
+
+    // Registry with all ciphers of this library ("aes-128-ctr", "rc4", "salsa20", ...)
+    static CipherRegistry &Instance();
+
+    template<MessageCipher T>
+    void Register(const std::string &name, size_t key_size) {
+        Register(name, key_size, [](const std::vector<uint8_t> &key) {
+            return std::make_unique<CipherImpl<T>>(key);
+        });
+    }
+
+    // key_size == 0 accepts keys of any length
+    void Register(const std::string &name, size_t key_size, Factory factory);
+
+    std::unique_ptr<Cipher> Create(std::string_view name, const std::vector<uint8_t> &key) const;
+
+    size_t GetKeySize(std::string_view name) const;
+
+    std::vector<std::string> GetNames() const;
+
+private:
+    struct Entry {
+        size_t key_size;
+        Factory factory;
+    };
+    const Entry &Find(std::string_view name) const;
+
+    std::map<std::string, Entry, std::less<>> _entries;
+};
+
+// Encrypts and decrypts size bytes, returns elapsed seconds
+double BenchmarkCipher(Cipher &cipher, size_t size);
+
+}
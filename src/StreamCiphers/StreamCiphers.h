@@ -2,12 +2,14 @@
 
 #include <AES/Aes.h>
 #include <utils.h>
+#include <algorithm>
+#include <type_traits>
 
 namespace algo::stream {
 
 namespace rc4 {
 
-void init_state(const uint8_t *key, size_t key_len, uint8_t *s) {
+inline void init_state(const uint8_t *key, size_t key_len, uint8_t *s) {
     constexpr size_t mod = 256;
     for(size_t i = 0; i < mod; i++) {
         s[i] = i;
@@ -20,23 +22,86 @@ void init_state(const uint8_t *key, size_t key_len, uint8_t *s) {
     }
 }
 
-void apply(const uint8_t *text, size_t text_len,
-           const uint8_t *key, size_t key_len,
-           uint8_t *out) {
-    constexpr size_t mod = 256;
-    uint8_t state[mod];
-    init_state(key, key_len, state);
+// Keeps the permutation and both indices between calls, so the key schedule
+// runs once per key and the keystream continues across Apply() calls.
+class Context {
+public:
+    static constexpr size_t kStateSize = 256;
+
+    Context(const uint8_t *key, size_t key_len, size_t drop = 0) {
+        init_state(key, key_len, _state);
+        Drop(drop);
+    }
+
+    // Discards next n keystream bytes (RC4-drop[n])
+    void Drop(size_t n) {
+        for(size_t it = 0; it < n; it++) {
+            Next();
+        }
+    }
+
+    void Apply(const uint8_t *text, size_t text_len, uint8_t *out) {
+        for(size_t it = 0; it < text_len; it++) {
+            out[it] = text[it] ^ Next();
+        }
+    }
+
+    inline uint8_t Next() {
+        _i = _i + 1;
+        _j = _j + _state[_i];
+
+        std::swap(_state[_i], _state[_j]);
+        const uint8_t t = _state[_i] + _state[_j];
+        return _state[t];
+    }
 
-    uint8_t i = 0, j = 0, t;
-    for(size_t it = 0; it < text_len; it++) {
-        i = (i + 1) % mod;
-        j = (j + state[i]) % mod;
+private:
+    uint8_t _state[kStateSize];
+    uint8_t _i = 0, _j = 0;
+};
 
-        std::swap(state[i], state[j]);
-        t = (state[i] + state[j]) % mod;
-        const uint8_t value = state[t];
+inline void apply(const uint8_t *text, size_t text_len,
+                  const uint8_t *key, size_t key_len,
+                  uint8_t *out) {
+    Context context(key, key_len);
+    context.Apply(text, text_len, out);
+}
+
+template<size_t Lanes>
+inline void apply_lanes(Context *contexts, const uint8_t *const *texts, uint8_t *const *outs, size_t len) {
+    // Each lane has its own serial dependency chain (j depends on the previous byte),
+    // stepping them in lockstep lets the CPU overlap independent chains.
+    for(size_t it = 0; it < len; it++) {
+        for(size_t lane = 0; lane < Lanes; lane++) {
+            outs[lane][it] = texts[lane][it] ^ contexts[lane].Next();
+        }
+    }
+}
 
-        out[it] = text[it] ^ value;
+// Advances count independent streams, contexts[k] encrypts lens[k] bytes of texts[k] into outs[k].
+// Streams are processed in groups of 8 (then 4) interleaved lanes, each context keeps its position
+// so sessions can be continued by later calls.
+inline void apply_batch(Context *contexts, const uint8_t *const *texts, uint8_t *const *outs,
+                        const size_t *lens, size_t count) {
+    constexpr size_t kMaxLanes = 8;
+    size_t first = 0;
+    auto run_group = [&](auto lanes_tag) {
+        constexpr size_t lanes = decltype(lanes_tag)::value;
+        const size_t common = *std::min_element(lens + first, lens + first + lanes);
+        apply_lanes<lanes>(contexts + first, texts + first, outs + first, common);
+        for(size_t lane = first; lane < first + lanes; lane++) {
+            contexts[lane].Apply(texts[lane] + common, lens[lane] - common, outs[lane] + common);
+        }
+        first += lanes;
+    };
+    while(count - first >= kMaxLanes) {
+        run_group(std::integral_constant<size_t, kMaxLanes>{});
+    }
+    if(count - first >= kMaxLanes / 2) {
+        run_group(std::integral_constant<size_t, kMaxLanes / 2>{});
+    }
+    for(; first < count; first++) {
+        contexts[first].Apply(texts[first], lens[first], outs[first]);
     }
 }
 
@@ -58,7 +123,13 @@ inline void qr(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d) {
     a ^= rotate(d + c, 18);
 }
 
-void apply(const uint8_t *in, size_t len,
+inline uint32_t load32(const uint8_t *p) {
+    // little-endian, independent of the host byte order
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+// key points to 32 bytes
+inline void apply(const uint8_t *in, size_t len,
                   const uint8_t *key,
                   const uint64_t nonce,
                   uint8_t *out) {
@@ -66,6 +137,10 @@ void apply(const uint8_t *in, size_t len,
     uint8_t* last_state8 = reinterpret_cast<uint8_t*>(last_state);
     uint32_t nonce_high_bits = nonce >> 32;
     uint32_t nonce_low_bits = nonce & ((1ull << 32) - 1);
+    uint32_t k[8];
+    for(size_t i = 0; i < 8; i++) {
+        k[i] = load32(key + 4 * i);
+    }
 
     for(size_t i = 0; i < len; i++) {
         if(i % 64 == 0) {
@@ -74,10 +149,10 @@ void apply(const uint8_t *in, size_t len,
             uint32_t pos_low_bits = i & ((1ull << 32) - 1);
 
             uint32_t s[] = {
-                FourCC("expa"), key[0],         key[1],         key[2],
-                key[3],         FourCC("nd 3"), pos_high_bits,  pos_low_bits,
-                nonce_high_bits,nonce_low_bits, FourCC("2-by"), key[4],
-                key[5],         key[6],         key[7],         FourCC("te k")
+                FourCC("expa"), k[0],           k[1],           k[2],
+                k[3],           FourCC("nd 3"), pos_high_bits,  pos_low_bits,
+                nonce_high_bits,nonce_low_bits, FourCC("2-by"), k[4],
+                k[5],           k[6],           k[7],           FourCC("te k")
             };
 
             constexpr size_t kNumRounds = 20 / 2;
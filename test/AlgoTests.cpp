@@ -2,6 +2,7 @@
 // Created by heimdall on 01.11.18.
 //
 
+#include <set>
 #include "gtest/gtest.h"
 #include <Algorithms/BigIntMath.h>
 
@@ -139,6 +140,52 @@ TEST(IsPrime, 1) {
     }
 }
 
+TEST(IsPrime, 2) {
+    const int MAX = 1'100'000;
+    vector<int> pr, lp;
+    algo::math::sieve(MAX, pr, lp);
+    // above 1000^2, so past trial division
+    for (int i = 1'000'001; i < MAX; i += 2) {
+        ASSERT_EQ(lp[i] == i, algo::math::isPrime(i)) << " num:" << i;
+    }
+    for (int i = -5; i < 1000; i++) {
+        ASSERT_EQ(i > 1 && lp[i] == i, algo::math::isPrime(i)) << " num:" << i;
+    }
+
+    // strong pseudoprimes to base 2 and strong Lucas pseudoprimes below 10^5
+    const std::set<int> base2 = {2047, 3277, 4033, 4681, 8321, 15841, 29341, 42799, 49141, 52633, 65281, 74665,
+                                 80581, 85489, 88357, 90751};
+    const std::set<int> lucas = {5459, 5777, 10877, 16109, 18971, 22499, 24569, 25199, 40309, 58519, 75077, 97439};
+    for (int i = 5; i < 100'000; i += 2) {
+        algo::math::MontgomeryContext context(i);
+        ASSERT_EQ(algo::math::isStrongProbablePrime(context, 2), lp[i] == i || base2.count(i)) << " num:" << i;
+        ASSERT_EQ(algo::math::isStrongLucasProbablePrime(context), lp[i] == i || lucas.count(i)) << " num:" << i;
+    }
+    ASSERT_TRUE(algo::math::isPrimeMillerRabin(2047, 1));
+    ASSERT_FALSE(algo::math::isPrimeMillerRabin(2047, 2));
+    ASSERT_FALSE(algo::math::isPrime(2047));
+    ASSERT_FALSE(algo::math::isPrime(5459));
+
+    BigInt mersenne = (BigInt(1) << 521) - 1;
+    ASSERT_TRUE(algo::math::isPrime(mersenne));
+    ASSERT_FALSE(algo::math::isPrime((BigInt(1) << 523) - 1));
+    ASSERT_FALSE(algo::math::isPrime(mersenne * mersenne));
+    ASSERT_FALSE(algo::math::isPrime(mersenne * ((BigInt(1) << 607) - 1)));
+}
+
+TEST(Jacobi, Jacobi_test_1) {
+    ASSERT_EQ(algo::math::Jacobi_symbol(1001, 9907), -1);
+    ASSERT_EQ(algo::math::Jacobi_symbol(19, 45), 1);
+    ASSERT_EQ(algo::math::Jacobi_symbol(8, 21), -1);
+    ASSERT_EQ(algo::math::Jacobi_symbol(-7, 15), 1);
+    ASSERT_EQ(algo::math::Jacobi_symbol(6, 15), 0);
+    ASSERT_EQ(algo::math::Jacobi_symbol(3, 8), 0);
+    for (int p : {3, 5, 7, 31, 61, 107})
+        for (int a = -20; a < 20; a++)
+            ASSERT_EQ(algo::math::Jacobi_symbol(a, p), algo::math::legendre_symbol(algo::math::normMod(a, p), p))
+                                << a << " " << p;
+}
+
 TEST(logMod, 1) {
     BigInt base = 3, ans = 13, mod = 17;
     ASSERT_EQ(ans, algo::math::powMod(base, algo::math::logMod(base, ans, mod), mod));
@@ -5,6 +5,14 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <BigInt/BigInt.h>
+#include <BigInt/Limbs.h>
+#include <BigInt/Arena.h>
+#include <BigInt/FixedUint.h>
+#include <Algorithms/BigIntMath.h>
+#include <Algorithms/PowWindows.h>
+#include <chrono>
+#include <omp.h>
+#include <random>
 
 using testing::Eq;
 
@@ -113,6 +121,42 @@ TEST(BigIntCompare, COMPARE_TEST_7){
 //    ASSERT_THAT(num>>=3, BigInt("0"));
 //}
 
+TEST(BigIntShift, SHIFT_BITS){
+    BigInt num("123456789012345678901234567890");
+    ASSERT_EQ(num << 1, num * 2);
+    ASSERT_EQ(num << 100, num * algo::math::pow(2, 100));
+    ASSERT_EQ((num << 100) >> 100, num);
+    ASSERT_EQ(num >> 64, num / BigInt("18446744073709551616"));
+    ASSERT_EQ(num >> 67, num / BigInt("147573952589676412928"));
+    ASSERT_EQ(num >> 97, 0);
+    ASSERT_EQ(-num >> 3, -(num / 8));
+    ASSERT_EQ(BigInt(0) << 1000, 0);
+}
+
+TEST(BigIntShift, BIT_ACCESS){
+    BigInt num("123456789012345678901234567890");
+    ASSERT_EQ(num.bit_length(), 97);
+    ASSERT_EQ(BigInt(0).bit_length(), 0);
+    ASSERT_EQ(BigInt(1).bit_length(), 1);
+    ASSERT_EQ(num.countr_zero(), 1);
+    ASSERT_EQ((num << 200).countr_zero(), 201);
+
+    BigInt rebuilt = 0;
+    for (size_t i = 0; i < num.bit_length(); i++) {
+        ASSERT_EQ(num.test_bit(i), (num >> i) % 2 == 1);
+        if (num.test_bit(i))
+            rebuilt.set_bit(i);
+    }
+    ASSERT_EQ(rebuilt, num);
+    ASSERT_FALSE(num.test_bit(1000));
+
+    rebuilt.set_bit(200);
+    ASSERT_EQ(rebuilt, num + (BigInt(1) << 200));
+    rebuilt.set_bit(200, false);
+    rebuilt.set_bit(96, false);
+    ASSERT_EQ(rebuilt.bit_length(), 96);
+}
+
 TEST(BigIntDivMod, DIVMOD_1){
     ASSERT_THAT(BigInt(100)/BigInt(5), BigInt(100/5));
 }
@@ -132,6 +176,1374 @@ TEST(BigIntDivMod, DIVMOD_3){
 }
 
 
+TEST(BigIntString, STRING_1){
+    for(std::string s : {"0", "1", "18446744073709551615", "18446744073709551616",
+                         "10000000000000000000", "9999999999999999999",
+                         "1606938044258990275541962092341162602522202993782792835301377",
+                         "-340282366920938463426481119284349108225"}){
+        ASSERT_EQ(BigInt(s).to_string(), s);
+    }
+    ASSERT_EQ(BigInt("000123").to_string(), "123");
+}
+
+TEST(BigIntString, STRING_LARGE){
+    // sizes around the divide-and-conquer threshold, numbers with long runs of zeros and nines
+    std::mt19937_64 rng(17);
+    for (size_t limbs : {1, 39, 40, 41, 80, 200, 1000}) {
+        BigUint num;
+        num.data.resize(limbs);
+        for (auto &limb : num.data)
+            limb = rng();
+        num.data.back() |= 1;
+        std::string s = num.to_string();
+        ASSERT_EQ(BigUint(s), num) << limbs;
+        ASSERT_NE(s[0], '0');
+        ASSERT_EQ(BigUint::fromHex(num.toHex()), num);
+    }
+    std::string power = "1" + std::string(2000, '0');
+    BigUint big(power);
+    ASSERT_EQ(big.to_string(), power);
+    ASSERT_EQ((big + 1).to_string(), "1" + std::string(1999, '0') + "1");
+    ASSERT_EQ((big - 1).to_string(), std::string(2000, '9'));
+    ASSERT_EQ(BigUint(std::string(1000, '0') + "42").to_string(), "42");
+
+    ASSERT_EQ(BigUint::fromHex("0xDEADbeef").to_string(), "3735928559");
+    ASSERT_EQ(BigUint(255).toHex(), "ff");
+    ASSERT_EQ(BigUint(0).toHex(), "0");
+    ASSERT_THROW(BigUint::fromHex("12g4"), std::invalid_argument);
+}
+
+TEST(BigIntString, BYTES){
+    const std::vector<uint8_t> bytes = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b};
+    BigUint big_endian = BigUint::fromBytes(bytes.data(), bytes.size());
+    BigUint little_endian = BigUint::fromBytes(bytes.data(), bytes.size(), std::endian::little);
+    ASSERT_EQ(big_endian.toHex(), "102030405060708090a0b");
+    ASSERT_EQ(little_endian.toHex(), "b0a090807060504030201");
+    ASSERT_EQ(big_endian.toBytes(), bytes);
+    ASSERT_EQ(little_endian.toBytes(std::endian::little), bytes);
+
+    uint8_t padded[16];
+    big_endian.toBytes(padded, sizeof(padded));
+    ASSERT_EQ(std::vector<uint8_t>(padded, padded + 5), std::vector<uint8_t>(5, 0));
+    ASSERT_EQ(std::vector<uint8_t>(padded + 5, padded + 16), bytes);
+    ASSERT_THROW(big_endian.toBytes(padded, 10), std::length_error);
+
+    ASSERT_TRUE(BigUint(0).toBytes().empty());
+    ASSERT_EQ(BigUint::fromBytes(nullptr, 0), BigUint(0));
+    ASSERT_EQ(BigInt::fromBytes(padded, sizeof(padded)), BigInt(big_endian.to_string()));
+}
+
+TEST(BigIntString, BigIntConversionBenchmark){
+    std::mt19937_64 rng(7);
+    for (size_t limbs : {40, 400, 4000, 20000}) {
+        BigUint num;
+        num.data.resize(limbs);
+        for (auto &limb : num.data)
+            limb = rng();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::string s = num.to_string();
+        auto t2 = std::chrono::high_resolution_clock::now();
+        BigUint parsed(s);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(parsed, num);
+        std::cout << "limbs: " << limbs << ", to_string: " << std::chrono::duration<double>(t2 - t1).count() * 1e3
+                  << "ms, parse: " << std::chrono::duration<double>(t3 - t2).count() * 1e3 << "ms" << std::endl;
+    }
+}
+
+TEST(BigIntLimbs, LIMBS_1){
+    BigInt max_limb("18446744073709551615");
+    ASSERT_EQ(max_limb * max_limb, BigInt("340282366920938463426481119284349108225"));
+    ASSERT_EQ(max_limb + 1, BigInt("18446744073709551616"));
+    ASSERT_EQ(BigInt("18446744073709551616") - 1, max_limb);
+}
+
+TEST(BigIntLimbs, LIMBS_2){
+    BigInt x("12345678901234567890123456789012345678901234567890");
+    BigInt y("98765432109876543210987654321098765432109876543210");
+    ASSERT_EQ(x * y, BigInt("1219326311370217952261850327338667885945115073915611949397448712086533622923332237463801111263526900"));
+    ASSERT_EQ(y - x, BigInt("86419753208641975320864197532086419753208641975320"));
+    ASSERT_EQ(x + y, BigInt("111111111011111111101111111110111111111011111111100"));
+    ASSERT_EQ(y / x, BigInt(8));
+    ASSERT_EQ(y % x, BigInt("900000000090000000009000000000900000000090"));
+
+    BigInt a("1606938044258990275541962092341162602522202993782792835301377");
+    BigInt b("18446744073709551619");
+    ASSERT_EQ(a / b, BigInt("87112285931760246632456800053923726493951"));
+    ASSERT_EQ(a % b, BigInt("18446744073709544708"));
+}
+
+TEST(BigIntDivMod, DIVMOD_KNUTH){
+    // limbs of all ones / single top bit make quotient digit estimation hit its corrections
+    std::mt19937_64 rng(42);
+    const limb_t patterns[] = {0, 1, ~limb_t(0), limb_t(1) << 63, (limb_t(1) << 63) - 1};
+    auto gen = [&](size_t limbs) {
+        BigUint num;
+        num.data.resize(limbs);
+        for (auto &limb : num.data)
+            limb = (rng() % 3 == 0 ? patterns[rng() % 5] : rng());
+        num.removeZeros();
+        return num;
+    };
+    for (int it = 0; it < 2000; it++) {
+        BigUint a = gen(1 + rng() % 12), b = gen(1 + rng() % 6);
+        if (b.isZero())
+            continue;
+        BigUint q, r;
+        divMod(a, b, q, r);
+        ASSERT_LT(r, b);
+        ASSERT_EQ(q * b + r, a);
+        ASSERT_EQ(a % b, r);
+    }
+}
+
+TEST(BigIntWord, CONSTRUCTORS){
+    ASSERT_EQ(BigInt(INT64_MIN).to_string(), "-9223372036854775808");
+    ASSERT_EQ(BigInt(-1).to_string(), "-1");
+    ASSERT_EQ(BigInt(0u).to_string(), "0");
+    ASSERT_EQ(BigUint(~limb_t(0)).to_string(), "18446744073709551615");
+    ASSERT_EQ(BigInt(short(-300)), BigInt("-300"));
+    ASSERT_THROW(BigUint(-1), std::logic_error);
+}
+
+TEST(BigIntWord, WORD_OPERATIONS){
+    // every operator with an integral operand agrees with the general BigInt one
+    std::mt19937_64 rng(5);
+    const long long words[] = {0, 1, -1, 2, -2, 3, 8, -8, 10, 1ll << 40, -(1ll << 40) - 7,
+                               INT64_MAX, INT64_MIN + 1, 1000000007};
+    for (int it = 0; it < 300; it++) {
+        BigInt a = 0;
+        for (size_t limb = rng() % 5; limb > 0; limb--)
+            a = a * BigInt("18446744073709551616") + BigInt(std::to_string(rng()));
+        if (rng() % 2)
+            a = -a;
+        for (long long w : words) {
+            BigInt b(std::to_string(w));
+            ASSERT_EQ(a + w, a + b);
+            ASSERT_EQ(w + a, a + b);
+            ASSERT_EQ(a - w, a - b);
+            ASSERT_EQ(w - a, b - a);
+            ASSERT_EQ(a * w, a * b);
+            ASSERT_EQ(w * a, a * b);
+            if (w == 0)
+                continue;
+            BigInt q = a / w, r = a % w;
+            ASSERT_EQ(q * b + r, a);
+            ASSERT_LT(algo::math::abs(r), algo::math::abs(b));
+            ASSERT_TRUE(r == 0 || r.sign == a.sign);
+        }
+        ASSERT_EQ(a.mag % ~limb_t(0), a.mag % BigUint(~limb_t(0)));
+        ASSERT_EQ(a.mag / 1000000007u, a.mag / BigUint(1000000007u));
+    }
+    ASSERT_THROW(BigInt(5) / 0, std::exception);
+    ASSERT_THROW(BigUint(5) - (-1), std::logic_error);
+    ASSERT_THROW(BigUint(3).subWord(5), std::logic_error);
+    ASSERT_THROW(BigUint(3) - 5, std::logic_error);
+    ASSERT_EQ(BigUint(5).subWord(5), 0);
+}
+
+TEST(BigIntCompound, COMPOUND_OPERATORS){
+    // compound, rvalue and divrem forms agree with the binary operators on lvalues
+    std::mt19937_64 rng(41);
+    auto gen = [&] {
+        BigInt a = 0;
+        for (size_t limb = rng() % 6; limb > 0; limb--)
+            a = a * BigInt("18446744073709551616") + BigInt(std::to_string(rng()));
+        if (rng() % 2)
+            a = -a;
+        return a;
+    };
+    for (int it = 0; it < 300; it++) {
+        const BigInt a = gen(), b = gen();
+        BigInt c = a;
+        ASSERT_EQ(c += b, a + b);
+        c = a;
+        ASSERT_EQ(c -= b, a - b);
+        c = a;
+        ASSERT_EQ(c *= b, a * b);
+        ASSERT_EQ(BigInt(a) + b, a + b);
+        ASSERT_EQ(a + BigInt(b), a + b);
+        ASSERT_EQ(BigInt(a) - BigInt(b), a - b);
+        ASSERT_EQ(a - BigInt(b), a - b);
+        ASSERT_EQ(a * BigInt(b), a * b);
+        ASSERT_EQ(-BigInt(a), -a);
+        if (b.isZero())
+            continue;
+        BigInt q, r;
+        divrem(a, b, q, r);
+        ASSERT_EQ(q * b + r, a);
+        ASSERT_LT(algo::math::abs(r), algo::math::abs(b));
+        ASSERT_TRUE(r.isZero() || r.sign == a.sign);
+        ASSERT_EQ(a / b, q);
+        ASSERT_EQ(a % b, r);
+        c = a;
+        ASSERT_EQ(c /= b, q);
+        c = a;
+        ASSERT_EQ(c %= b, r);
+        ASSERT_EQ(BigInt(a) % b, r);
+
+        // outputs aliasing the inputs
+        BigInt x = a, y = b;
+        divrem(x, y, x, y);
+        ASSERT_EQ(x, q);
+        ASSERT_EQ(y, r);
+        x = a, y = b;
+        divrem(x, y, y, x);
+        ASSERT_EQ(y, q);
+        ASSERT_EQ(x, r);
+    }
+
+    BigInt x = BigInt("-123456789012345678901234567890");
+    ASSERT_EQ(x += x, BigInt("-246913578024691357802469135780"));
+    ASSERT_EQ(x -= x, 0);
+    ASSERT_EQ(x.sign, 1);
+    x = BigInt("-123456789012345678901234567890");
+    ASSERT_EQ(x *= x, BigInt("15241578753238836750495351562536198787501905199875019052100"));
+    ASSERT_EQ(x /= x, 1);
+    x = BigInt("-123456789012345678901234567890");
+    ASSERT_EQ(x %= x, 0);
+    ASSERT_EQ(x.sign, 1);
+    x = 7;
+    ASSERT_EQ((x += 5) *= -3, -36);
+    ASSERT_EQ(x %= 10, -6);
+    ASSERT_THROW(x /= BigInt(0), std::exception);
+
+    BigUint u("340282366920938463463374607431768211456");
+    BigUint v = u;
+    ASSERT_EQ(v.subtractFrom(u + 1), 1);
+    ASSERT_EQ(u - BigUint(5), BigUint("340282366920938463463374607431768211451"));
+    ASSERT_THROW(v -= u, std::logic_error);
+    ASSERT_THROW(v.subtractFrom(0), std::logic_error);
+}
+
+TEST(BigIntStorage, SMALL_VECTOR){
+    SmallVector<limb_t, 4> v(3, 7);
+    ASSERT_TRUE(v.isInline());
+    v.push_back(8);
+    ASSERT_TRUE(v.isInline());
+    v.push_back(v[0]);
+    ASSERT_FALSE(v.isInline());
+    ASSERT_EQ(v, (SmallVector<limb_t, 4>{7, 7, 7, 8, 7}));
+
+    SmallVector<limb_t, 4> copy = v;
+    const limb_t *heap = v.data();
+    SmallVector<limb_t, 4> moved = std::move(v);
+    ASSERT_EQ(moved.data(), heap);
+    ASSERT_TRUE(v.empty() && v.isInline());
+    ASSERT_EQ(copy, moved);
+
+    moved.resize(2);
+    SmallVector<limb_t, 4> small = moved;
+    ASSERT_TRUE(small.isInline());
+    small.resize(4);
+    ASSERT_EQ(small, (SmallVector<limb_t, 4>{7, 7, 0, 0}));
+}
+
+TEST(BigIntStorage, INLINE_LIMBS){
+    // 512-bit modular arithmetic stays within the inline buffer
+    BigUint x("12345678901234567890123456789012345678901234567890123456789");
+    x <<= 256;
+    ASSERT_EQ(x.data.size(), 8);
+    ASSERT_TRUE(x.data.isInline());
+    BigUint product = x * x, sum = x + x, diff = product - x;
+    ASSERT_TRUE(product.data.isInline());
+    ASSERT_TRUE(sum.data.isInline());
+    ASSERT_TRUE(diff.data.isInline());
+    ASSERT_EQ(product % x, BigUint(0));
+
+    BigUint big = product * product;
+    ASSERT_FALSE(big.data.isInline());
+    ASSERT_EQ(big / product, product);
+}
+
+TEST(BigIntArena, POOL){
+    // blocks come back from the free list of their size class
+    void *a = limbs::poolAllocate(300), *b = limbs::poolAllocate(1000);
+    limbs::poolDeallocate(a, 300);
+    limbs::poolDeallocate(b, 1000);
+    const size_t before = limbs::heapAllocations();
+    ASSERT_EQ(limbs::poolAllocate(512), a);
+    ASSERT_EQ(limbs::poolAllocate(1024), b);
+    ASSERT_EQ(limbs::heapAllocations(), before);
+    limbs::poolDeallocate(a, 512);
+    limbs::poolDeallocate(b, 1024);
+
+    BigUint x;
+    x.data.resize(100, 5);
+    ASSERT_FALSE(x.data.isInline());
+    BigUint y = x * x;
+    ASSERT_EQ(y % x, BigUint(0));
+}
+
+TEST(BigIntArena, WORKSPACE){
+    limb_t *first;
+    {
+        limbs::Workspace outer;
+        first = outer.alloc<limb_t>(10);
+        limb_t *second = outer.alloc<limb_t>(3);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(second) % 64, 0u);
+        ASSERT_GE(second, first + 10);
+        {
+            limbs::Workspace inner;
+            limb_t *big = inner.alloc<limb_t>(1 << 20);
+            std::fill(big, big + (1 << 20), 1);
+            ASSERT_NE(big, first);
+        }
+        // memory of the inner workspace is reused
+        limbs::Workspace again;
+        const size_t before = limbs::heapAllocations();
+        again.alloc<limb_t>(1 << 20);
+        ASSERT_EQ(limbs::heapAllocations(), before);
+    }
+    limbs::Workspace next;
+    ASSERT_EQ(next.alloc<limb_t>(1), first);
+}
+
+TEST(BigIntArena, STEADY_STATE){
+    // 2048-bit modular exponentiation allocates nothing from the heap once the pool is warm
+    std::mt19937_64 rng(23);
+    std::vector<uint8_t> bytes(256);
+    auto gen = [&] {
+        for (auto &byte : bytes)
+            byte = uint8_t(rng());
+        return BigInt::fromBytes(bytes.data(), bytes.size());
+    };
+    BigInt mod = gen(), power = gen() % 100000;
+    mod.set_bit(0);
+    BigInt base = gen() % mod;
+    BigInt res = algo::math::powMod(base, power, mod);
+    res = algo::math::powMod(res, power, mod);
+    const size_t before = limbs::heapAllocations();
+    for (int it = 0; it < 3; it++)
+        res = algo::math::powMod(res, power, mod);
+    ASSERT_EQ(limbs::heapAllocations(), before);
+}
+
+TEST(BigIntKernels, KERNELS){
+    // portable and MULX/ADCX/ADOX kernels agree, including all-ones limbs that carry through
+    if (!limbs::adx::supported())
+        GTEST_SKIP() << "no BMI2/ADX";
+    std::mt19937_64 rng(3);
+    for (size_t n : {1, 2, 3, 7, 16, 33}) {
+        for (int it = 0; it < 50; it++) {
+            std::vector<limb_t> a(n), b(n);
+            for (size_t i = 0; i < n; i++) {
+                a[i] = (rng() % 3 == 0 ? ~limb_t(0) : rng());
+                b[i] = (rng() % 3 == 0 ? ~limb_t(0) : rng());
+            }
+            limb_t v = (it % 4 == 0 ? ~limb_t(0) : rng());
+            std::vector<limb_t> expected(n), actual(n);
+
+            ASSERT_EQ(limbs::portable::add_n(expected.data(), a.data(), b.data(), n),
+                      limbs::adx::add_n(actual.data(), a.data(), b.data(), n));
+            ASSERT_EQ(expected, actual);
+            ASSERT_EQ(limbs::portable::sub_n(expected.data(), a.data(), b.data(), n),
+                      limbs::adx::sub_n(actual.data(), a.data(), b.data(), n));
+            ASSERT_EQ(expected, actual);
+            ASSERT_EQ(limbs::portable::mul_1(expected.data(), a.data(), n, v),
+                      limbs::adx::mul_1(actual.data(), a.data(), n, v));
+            ASSERT_EQ(expected, actual);
+
+            expected = actual = b;
+            ASSERT_EQ(limbs::portable::addmul_1(expected.data(), a.data(), n, v),
+                      limbs::adx::addmul_1(actual.data(), a.data(), n, v));
+            ASSERT_EQ(expected, actual);
+            ASSERT_EQ(limbs::portable::submul_1(expected.data(), a.data(), n, v),
+                      limbs::adx::submul_1(actual.data(), a.data(), n, v));
+            ASSERT_EQ(expected, actual);
+        }
+    }
+}
+
+TEST(BigIntKernels, BigIntKernelsBenchmark){
+    std::mt19937_64 rng(7);
+    const size_t n = 64;
+    const int reps = 200000;
+    std::vector<limb_t> a(n), r(n);
+    for (size_t i = 0; i < n; i++)
+        a[i] = r[i] = rng();
+    auto measure = [&](auto &&func) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < reps; it++)
+            func(limb_t(it) | 1);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double>(t2 - t1).count() / reps / n * 1e9;
+    };
+    std::cout << "ns per limb, portable addmul_1: "
+              << measure([&](limb_t v) { limbs::portable::addmul_1(r.data(), a.data(), n, v); })
+              << ", add_n: " << measure([&](limb_t) { limbs::portable::add_n(r.data(), r.data(), a.data(), n); });
+    if (limbs::adx::supported()) {
+        std::cout << "; adx addmul_1: "
+                  << measure([&](limb_t v) { limbs::adx::addmul_1(r.data(), a.data(), n, v); })
+                  << ", add_n: " << measure([&](limb_t) { limbs::adx::add_n(r.data(), r.data(), a.data(), n); });
+    }
+    std::cout << std::endl;
+}
+
+TEST(BigIntMul, MUL_ALGORITHMS){
+    std::mt19937_64 rng(7);
+    auto gen = [&](size_t limbs) {
+        std::vector<limb_t> num(limbs);
+        for (auto &limb : num)
+            limb = (rng() % 4 == 0 ? ~limb_t(0) : rng());
+        return num;
+    };
+    const std::pair<size_t, size_t> sizes[] = {{40, 40}, {41, 33}, {100, 35}, {257, 256}, {300, 101},
+                                               {480, 470}, {481, 330}, {700, 699}, {1000, 400}};
+    for (auto [n, m] : sizes) {
+        auto a = gen(n), b = gen(m);
+        std::vector<limb_t> expected(n + m), actual(n + m), scratch(limbs::mulScratchSize(n, m));
+        limbs::mulBasecase(expected.data(), a.data(), n, b.data(), m);
+        limbs::mul(actual.data(), a.data(), n, b.data(), m, scratch.data());
+        ASSERT_EQ(expected, actual) << n << "x" << m;
+    }
+}
+
+TEST(BigIntMul, BigIntMulBenchmark){
+    // one top level of each algorithm, used to pick thresholds in Limbs.h
+    std::mt19937_64 rng(7);
+    for (size_t n : {16, 24, 32, 48, 64, 96, 128, 160, 192, 256, 384, 512}) {
+        std::vector<limb_t> a(n), b(n), r(2 * n), scratch(8 * n + 1024);
+        for (size_t i = 0; i < n; i++) {
+            a[i] = rng();
+            b[i] = rng();
+        }
+        const int reps = int(5'000'000 / (n * n)) + 1;
+        auto measure = [&](auto &&func) {
+            auto t1 = std::chrono::high_resolution_clock::now();
+            for (int it = 0; it < reps; it++)
+                func();
+            auto t2 = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double>(t2 - t1).count() / reps * 1e6;
+        };
+        double basecase = measure([&] { limbs::mulBasecase(r.data(), a.data(), n, b.data(), n); });
+        double karatsuba = measure([&] { limbs::mulKaratsuba(r.data(), a.data(), n, b.data(), n, scratch.data()); });
+        double toom3 = measure([&] { limbs::mulToom3(r.data(), a.data(), n, b.data(), n, scratch.data()); });
+        std::cout << "limbs: " << n << ", basecase: " << basecase << "us, karatsuba: " << karatsuba
+                  << "us, toom3: " << toom3 << "us" << std::endl;
+    }
+}
+
+TEST(BigIntMul, MUL_NTT){
+    std::mt19937_64 rng(11);
+    for (auto [n, m] : {std::pair<size_t, size_t>{1, 1}, {5, 3}, {300, 300}, {1000, 37}, {2500, 2100}}) {
+        std::vector<limb_t> a(n, ~limb_t(0)), b(m, ~limb_t(0));
+        if (n > 1) {
+            for (auto &limb : a) limb = rng();
+            for (auto &limb : b) limb = rng();
+        }
+        std::vector<limb_t> expected(n + m), actual(n + m), scratch(limbs::mulScratchSize(n, m));
+        limbs::mulBasecase(expected.data(), a.data(), n, b.data(), m);
+        limbs::mulNtt(actual.data(), a.data(), n, b.data(), m);
+        ASSERT_EQ(expected, actual) << n << "x" << m;
+    }
+}
+
+TEST(BigIntMul, BigIntNttBenchmark){
+    // 52000 limbs is about a million decimal digits
+    std::mt19937_64 rng(7);
+    for (size_t n : {1024, 4096, 8192, 16384, 52000}) {
+        std::vector<limb_t> a(n), b(n), r(2 * n), scratch(limbs::mulScratchSize(n, n) + 8 * n);
+        for (size_t i = 0; i < n; i++) {
+            a[i] = rng();
+            b[i] = rng();
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        limbs::mulToom3(r.data(), a.data(), n, b.data(), n, scratch.data());
+        auto t2 = std::chrono::high_resolution_clock::now();
+        limbs::mulNtt(r.data(), a.data(), n, b.data(), n);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        std::cout << "limbs: " << n << ", toom3: " << std::chrono::duration<double>(t2 - t1).count() * 1e3
+                  << "ms, ntt: " << std::chrono::duration<double>(t3 - t2).count() * 1e3 << "ms" << std::endl;
+    }
+}
+
+TEST(BigIntSqr, SQR_ALGORITHMS){
+    std::mt19937_64 rng(13);
+    for (size_t n : {1, 2, 17, 47, 48, 49, 100, 191, 192, 300, 577, 1000, 9000}) {
+        std::vector<limb_t> a(n);
+        for (auto &limb : a)
+            limb = (rng() % 4 == 0 ? ~limb_t(0) : rng());
+        std::vector<limb_t> expected(2 * n), actual(2 * n), scratch(limbs::mulScratchSize(n, n));
+        limbs::mulBasecase(expected.data(), a.data(), n, a.data(), n);
+        limbs::sqr(actual.data(), a.data(), n, scratch.data());
+        ASSERT_EQ(expected, actual) << n;
+    }
+    std::vector<limb_t> ones(300, ~limb_t(0)), expected(600), actual(600), scratch(limbs::mulScratchSize(300, 300));
+    limbs::mulBasecase(expected.data(), ones.data(), 300, ones.data(), 300);
+    limbs::sqr(actual.data(), ones.data(), 300, scratch.data());
+    ASSERT_EQ(expected, actual);
+
+    BigUint x("123456789012345678901234567890123456789");
+    BigUint copy = x;
+    ASSERT_EQ((x * copy).to_string(), "15241578753238836750495351562566681945005334557625361987875019051998750190521");
+}
+
+TEST(BigIntSqr, BigIntSqrBenchmark){
+    // squaring against general multiplication, used to pick squaring thresholds in Limbs.h
+    std::mt19937_64 rng(7);
+    for (size_t n : {16, 32, 48, 64, 128, 192, 256, 512, 1024, 16384}) {
+        std::vector<limb_t> a(n), b(n), r(2 * n), scratch(limbs::mulScratchSize(n, n) + 8 * n + 1024);
+        for (size_t i = 0; i < n; i++)
+            b[i] = a[i] = rng();
+        const int reps = int(5'000'000 / (n * n)) + 1;
+        auto measure = [&](auto &&func) {
+            auto t1 = std::chrono::high_resolution_clock::now();
+            for (int it = 0; it < reps; it++)
+                func();
+            auto t2 = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double>(t2 - t1).count() / reps * 1e6;
+        };
+        double mul = measure([&] { limbs::mul(r.data(), a.data(), n, b.data(), n, scratch.data()); });
+        double sqr = measure([&] { limbs::sqr(r.data(), a.data(), n, scratch.data()); });
+        double karatsuba = measure([&] { limbs::sqrKaratsuba(r.data(), a.data(), n, scratch.data()); });
+        double toom3 = measure([&] { limbs::sqrToom3(r.data(), a.data(), n, scratch.data()); });
+        std::cout << "limbs: " << n << ", mul: " << mul << "us, sqr: " << sqr << "us, sqr karatsuba: "
+                  << karatsuba << "us, sqr toom3: " << toom3 << "us" << std::endl;
+    }
+}
+
+
+TEST(BigIntDivMod, DIVMOD_NEWTON){
+    std::mt19937_64 rng(17);
+    const limb_t patterns[] = {0, 1, ~limb_t(0), limb_t(1) << 63, (limb_t(1) << 63) - 1};
+    auto gen = [&](size_t limbs, bool all_ones) {
+        std::vector<limb_t> num(limbs);
+        for (auto &limb : num)
+            limb = (all_ones ? ~limb_t(0) : rng() % 3 == 0 ? patterns[rng() % 5] : rng());
+        return num;
+    };
+    const std::pair<size_t, size_t> sizes[] = {{1500, 1500}, {1, 1600}, {2000, 1500}, {3999, 1501}, {3100, 3100}};
+    for (auto [m, n] : sizes) {
+        for (bool all_ones : {false, true}) {
+            auto v = gen(n, all_ones), u = gen(m + n + 1, all_ones);
+            v[n - 1] |= limb_t(1) << 63;
+            u[m + n] = 0;
+            u[m + n - 1] = std::min(u[m + n - 1], v[n - 1] - 1);
+            std::vector<limb_t> u_knuth = u, q_knuth(m + 1), q_newton(m + 1);
+            limbs::divideKnuth(u_knuth.data(), m, v.data(), n, q_knuth.data());
+            limbs::divideNewton(u.data(), m, v.data(), n, q_newton.data());
+            ASSERT_EQ(q_knuth, q_newton) << m << "/" << n;
+            ASSERT_TRUE(std::equal(u.begin(), u.begin() + n, u_knuth.begin())) << m << "/" << n;
+        }
+    }
+
+    BigUint a, b;
+    a.data.resize(5000);
+    b.data.resize(1700);
+    for (auto &limb : a.data) limb = rng();
+    for (auto &limb : b.data) limb = rng() >> 7;
+    BigUint q, r;
+    divMod(a, b, q, r);
+    ASSERT_LT(r, b);
+    ASSERT_EQ(q * b + r, a);
+}
+
+TEST(BigIntDivMod, BigIntDivBenchmark){
+    // 2n by n limbs, used to pick kDivNewtonThreshold in Limbs.h
+    std::mt19937_64 rng(7);
+    for (size_t n : {100, 400, 1000, 2000, 4000, 10000}) {
+        std::vector<limb_t> v(n), u(2 * n + 1), q(n + 1);
+        for (auto &limb : v) limb = rng();
+        v[n - 1] |= limb_t(1) << 63;
+        auto reset = [&] {
+            for (auto &limb : u) limb = rng();
+            u[2 * n] = 0;
+            u[2 * n - 1] = std::min(u[2 * n - 1], v[n - 1] - 1);
+        };
+        reset();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        limbs::divideKnuth(u.data(), n, v.data(), n, q.data());
+        auto t2 = std::chrono::high_resolution_clock::now();
+        reset();
+        auto t3 = std::chrono::high_resolution_clock::now();
+        limbs::divideNewton(u.data(), n, v.data(), n, q.data());
+        auto t4 = std::chrono::high_resolution_clock::now();
+        std::cout << "limbs: " << n << ", knuth: " << std::chrono::duration<double>(t2 - t1).count() * 1e3
+                  << "ms, newton: " << std::chrono::duration<double>(t4 - t3).count() * 1e3 << "ms" << std::endl;
+    }
+}
+
+TEST(BigIntParallel, PARALLEL_MUL){
+    // forces a team of 4 threads even on a single core machine, results must match the sequential ones
+    std::mt19937_64 rng(19);
+    const int threads = omp_get_max_threads();
+    const std::pair<size_t, size_t> sizes[] = {{2500, 2100}, {6000, 5000}, {20000, 20000}};
+    for (auto [n, m] : sizes) {
+        std::vector<limb_t> a(n), b(m), expected(n + m), actual(n + m), sq_expected(2 * n), sq_actual(2 * n);
+        std::vector<limb_t> scratch(limbs::mulScratchSize(n, m) + limbs::mulScratchSize(n, n));
+        for (auto &limb : a) limb = rng();
+        for (auto &limb : b) limb = rng();
+        omp_set_num_threads(1);
+        limbs::mul(expected.data(), a.data(), n, b.data(), m, scratch.data());
+        limbs::sqr(sq_expected.data(), a.data(), n, scratch.data());
+        omp_set_num_threads(4);
+        limbs::mul(actual.data(), a.data(), n, b.data(), m, scratch.data());
+        limbs::sqr(sq_actual.data(), a.data(), n, scratch.data());
+        omp_set_num_threads(threads);
+        ASSERT_EQ(expected, actual) << n << "x" << m;
+        ASSERT_EQ(sq_expected, sq_actual) << n;
+    }
+
+    BigUint x, y;
+    x.data.resize(12000);
+    y.data.resize(5000);
+    for (auto &limb : x.data) limb = rng();
+    for (auto &limb : y.data) limb = rng();
+    omp_set_num_threads(4);
+    BigUint q = x / y, r = x % y;
+    omp_set_num_threads(threads);
+    ASSERT_LT(r, y);
+    ASSERT_EQ(q * y + r, x);
+}
+
+TEST(BigIntParallel, BigIntParallelBenchmark){
+    std::mt19937_64 rng(7);
+    const int threads = omp_get_max_threads();
+    for (size_t n : {4096, 52000}) {
+        BigUint a, b;
+        a.data.resize(2 * n);
+        b.data.resize(n);
+        for (auto &limb : a.data) limb = rng();
+        for (auto &limb : b.data) limb = rng();
+        for (int team : {1, omp_get_num_procs()}) {
+            omp_set_num_threads(team);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            BigUint prod = b * b;
+            auto t2 = std::chrono::high_resolution_clock::now();
+            BigUint q = a / b;
+            auto t3 = std::chrono::high_resolution_clock::now();
+            std::cout << "limbs: " << n << ", threads: " << team << ", square: "
+                      << std::chrono::duration<double>(t2 - t1).count() * 1e3 << "ms, 2n/n division: "
+                      << std::chrono::duration<double>(t3 - t2).count() * 1e3 << "ms" << std::endl;
+        }
+    }
+    omp_set_num_threads(threads);
+}
+
+TEST(BigIntFixed, ARITHMETIC){
+    using U256 = FixedUint<256>;
+    static_assert(U256(5) + U256(7) == U256(12));
+    static_assert((U256(0) - U256(1)).bit_length() == 256);
+    static_assert(U256::compare(U256(3), U256(4)) == -1);
+
+    std::mt19937_64 rng(11);
+    const BigInt two_256 = BigInt(1) << 256;
+    for (int iter = 0; iter < 200; iter++) {
+        U256 a, b;
+        for (size_t i = 0; i < U256::kLimbs; i++) {
+            a.data[i] = (iter % 4 == 0 ? ~limb_t(0) : rng());
+            b.data[i] = (iter % 5 == 0 && i > 1 ? 0 : rng());
+        }
+        const BigInt x = a.toBigInt(), y = b.toBigInt();
+        ASSERT_EQ(U256(x), a);
+        ASSERT_EQ((a + b).toBigInt(), (x + y) % two_256);
+        ASSERT_EQ((a - b).toBigInt(), (x - y + two_256) % two_256);
+        ASSERT_EQ((a * b).toBigInt(), x * y % two_256);
+        ASSERT_EQ(a.mulWide(b).toBigInt(), x * y);
+        ASSERT_EQ((a % b).toBigInt(), x % y);
+        ASSERT_EQ(U256::compare(a, b), x.compareTo(y));
+        ASSERT_EQ(a < b, x < y);
+        ASSERT_EQ(U256::select(iter & 1, a, b), (iter & 1) ? a : b);
+    }
+
+    FixedUint<2048> big(BigInt(1) << 2000), small(BigInt("123456789012345678901234567890"));
+    ASSERT_EQ(big.mulWide(small).toBigInt(), (BigInt(1) << 2000) * BigInt("123456789012345678901234567890"));
+    ASSERT_THROW(FixedUint<64>(BigInt(1) << 64), std::length_error);
+    ASSERT_THROW(U256(BigInt(-1)), std::logic_error);
+}
+
+TEST(BigIntFixed, EC_FIELD){
+    // doubling of the secp256k1 generator, y^2 = x^3 + 7 over p = 2^256 - 2^32 - 977
+    using U256 = FixedUint<256>;
+    using namespace algo::math;
+    const BigInt p = (BigInt(1) << 256) - (BigInt(1) << 32) - 977;
+    const U256 fp(p);
+    const U256 x(BigUint::fromHex("79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798"));
+    const U256 y(BigUint::fromHex("483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"));
+    const BigInt gx = x.toBigInt(), gy = y.toBigInt();
+
+    ASSERT_EQ(mulMod(y, y, fp), addMod(mulMod(mulMod(x, x, fp), x, fp), U256(7), fp));
+
+    const U256 slope = mulMod(mulMod(U256(3), mulMod(x, x, fp), fp), inverseMod(addMod(y, y, fp), fp), fp);
+    const U256 x2 = subMod(subMod(mulMod(slope, slope, fp), x, fp), x, fp);
+    const U256 y2 = subMod(mulMod(slope, subMod(x, x2, fp), fp), y, fp);
+
+    const BigInt big_slope = 3 * gx * gx * inverseMod(2 * gy, p) % p;
+    const BigInt big_x2 = normMod(big_slope * big_slope - 2 * gx, p);
+    ASSERT_EQ(x2.toBigInt(), big_x2);
+    ASSERT_EQ(y2.toBigInt(), normMod(big_slope * (gx - big_x2) - gy, p));
+    ASSERT_EQ(x2.toBigUint(), BigUint::fromHex("C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5"));
+}
+
+TEST(BigIntFixed, RSA_POWMOD){
+    std::mt19937_64 rng(5);
+    FixedUint<1024> base, power, mod;
+    for (size_t i = 0; i < FixedUint<1024>::kLimbs; i++) {
+        base.data[i] = rng();
+        power.data[i] = rng();
+        mod.data[i] = rng() | 1;
+    }
+    base = base % mod;
+    ASSERT_EQ(algo::math::powMod(base, power, mod).toBigInt(),
+              algo::math::powMod(base.toBigInt(), power.toBigInt(), mod.toBigInt()));
+    ASSERT_EQ(algo::math::powMod(base, FixedUint<64>(65537), mod).toBigInt(),
+              algo::math::powMod(base.toBigInt(), 65537, mod.toBigInt()));
+}
+
+TEST(BigIntFixed, BigIntFixedBenchmark){
+    using U256 = FixedUint<256>;
+    std::mt19937_64 rng(3);
+    const BigInt p = (BigInt(1) << 256) - (BigInt(1) << 32) - 977;
+    const U256 fp(p);
+    U256 a, b;
+    for (size_t i = 0; i < U256::kLimbs; i++) {
+        a.data[i] = rng();
+        b.data[i] = rng();
+    }
+    a = a % fp;
+    b = b % fp;
+    BigInt x = a.toBigInt(), y = b.toBigInt();
+
+    const int iterations = 100000;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++)
+        a = algo::math::mulMod(algo::math::addMod(a, b, fp), b, fp);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++)
+        x = (x + y) % p * y % p;
+    auto t3 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(a.toBigInt(), x);
+    std::cout << "256-bit (a + b) * b mod p, FixedUint: "
+              << std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations << "ns, BigInt: "
+              << std::chrono::duration<double, std::nano>(t3 - t2).count() / iterations << "ns" << std::endl;
+}
+
+// square-and-multiply with a division per step, reference for the reduction contexts
+static BigUint powModByDivision(const BigUint &base, const BigUint &power, const BigUint &mod) {
+    BigUint res = BigUint(1) % mod, x = base % mod;
+    for (size_t i = power.bit_length(); i-- > 0;) {
+        res *= res;
+        res %= mod;
+        if (power.test_bit(i)) {
+            res *= x;
+            res %= mod;
+        }
+    }
+    return res;
+}
+
+static BigUint randomBigUint(std::mt19937_64 &rng, size_t limbs) {
+    BigUint res;
+    res.data.resize(limbs);
+    for (auto &limb : res.data)
+        limb = rng();
+    res.removeZeros();
+    return res;
+}
+
+TEST(BigIntMontgomery, MONTGOMERY){
+    std::mt19937_64 rng(42);
+    for (size_t k : {1, 2, 3, 5, 8, 16, 17, 33, 40}) {
+        for (int it = 0; it < 5; it++) {
+            BigUint mod = randomBigUint(rng, k);
+            mod.set_bit(0);
+            if (it == 0)
+                mod.data.back() |= limb_t(1) << 63;
+            algo::math::MontgomeryContext context(mod);
+            BigUint a = randomBigUint(rng, k) % mod, b = randomBigUint(rng, k + 1);
+            BigUint am = context.toMontgomery(a), bm = context.toMontgomery(b), r;
+            ASSERT_EQ(context.fromMontgomery(am), a);
+            context.mul(r, am, bm);
+            ASSERT_EQ(context.fromMontgomery(r), a * b % mod);
+            context.sqr(r, am);
+            ASSERT_EQ(context.fromMontgomery(r), a * a % mod);
+            context.mul(am, am, am);
+            ASSERT_EQ(am, r);
+
+            BigUint power = randomBigUint(rng, 1 + rng() % 3);
+            ASSERT_EQ(context.pow(b, power), powModByDivision(b, power, mod));
+            ASSERT_EQ(context.pow(b, 0), 1);
+            BigInt base = -BigInt(std::to_string(rng())), m = BigInt(mod.to_string());
+            ASSERT_EQ(algo::math::powMod(base, BigInt(power.to_string()), m).mag,
+                      powModByDivision(algo::math::normMod(base, m).mag, power, mod));
+        }
+    }
+    ASSERT_EQ(algo::math::MontgomeryContext(1).pow(5, 3), 0);
+    ASSERT_EQ(algo::math::powMod(5, 117, 1), 0);
+    ASSERT_THROW(algo::math::MontgomeryContext(BigUint(10)), std::invalid_argument);
+}
+
+TEST(BigIntMontgomery, BigIntMontgomeryBenchmark){
+    std::mt19937_64 rng(7);
+    for (size_t k : {4, 16, 32, 64}) {
+        BigUint mod = randomBigUint(rng, k), base = randomBigUint(rng, k), power = randomBigUint(rng, k);
+        mod.set_bit(0);
+        mod.set_bit(k * BigUint::limb_bits - 1);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        BigUint x = algo::math::MontgomeryContext(mod).pow(base, power);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        BigUint y = powModByDivision(base, power, mod);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(x, y);
+        std::cout << k * BigUint::limb_bits << "-bit powMod, Montgomery: "
+                  << std::chrono::duration<double, std::micro>(t2 - t1).count() << "us, division: "
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() << "us" << std::endl;
+    }
+}
+
+TEST(BigIntBarrett, BARRETT){
+    std::mt19937_64 rng(43);
+    for (size_t k : {1, 2, 3, 7, 16, 31, 32, 40, 100}) {
+        for (int it = 0; it < 10; it++) {
+            BigUint mod = randomBigUint(rng, k);
+            if (it == 0)
+                mod.data.back() |= limb_t(1) << 63;
+            if (it == 1)
+                mod = BigUint(1) << (k * BigUint::limb_bits - 1);
+            if (it == 2)
+                mod.data.back() = 1;
+            mod.set_bit(1, it % 2 == 0);
+            algo::math::BarrettContext context(mod);
+            for (size_t n : {size_t(1), k, k + 1, 2 * k - 1, 2 * k, 2 * k + 3}) {
+                BigUint x = randomBigUint(rng, n), r = x;
+                context.reduce(r);
+                ASSERT_EQ(r, x % mod) << k << " " << n;
+            }
+            BigUint a = randomBigUint(rng, k) % mod, b = randomBigUint(rng, k) % mod;
+            BigInt m = BigInt(mod.to_string()), x = BigInt(a.to_string()), y = -BigInt(b.to_string());
+            ASSERT_EQ(algo::math::mulMod(x, y, context), algo::math::mulMod(x, y, m));
+            ASSERT_EQ(algo::math::addMod(x, y, context), algo::math::addMod(x, y, m));
+            ASSERT_EQ(algo::math::subMod(y, x, context), algo::math::subMod(y, x, m));
+            ASSERT_EQ(algo::math::normMod(y, context), algo::math::normMod(y, m));
+
+            BigUint power = randomBigUint(rng, 1);
+            ASSERT_EQ(algo::math::powMod(x, BigInt(power.to_string()), m).mag, powModByDivision(a, power, mod));
+        }
+    }
+    ASSERT_THROW(algo::math::BarrettContext(BigUint(0)), std::exception);
+}
+
+TEST(BigIntBarrett, BigIntBarrettBenchmark){
+    std::mt19937_64 rng(11);
+    for (size_t k : {4, 32, 64, 200, 2000}) {
+        BigUint mod = randomBigUint(rng, k);
+        mod.set_bit(k * BigUint::limb_bits - 1);
+        algo::math::BarrettContext context(mod);
+        std::vector<BigUint> products;
+        for (int i = 0; i < 20; i++)
+            products.push_back(randomBigUint(rng, k) * randomBigUint(rng, k));
+        const int rounds = std::max<int>(1, 20000 / int(k));
+        BigUint x, y;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; round++)
+            for (auto &product : products) {
+                x = product;
+                context.reduce(x);
+            }
+        auto t2 = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; round++)
+            for (auto &product : products)
+                y = product % mod;
+        auto t3 = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(x, y);
+        const int count = rounds * int(products.size());
+        std::cout << k * BigUint::limb_bits << "-bit modulus, Barrett: "
+                  << std::chrono::duration<double, std::micro>(t2 - t1).count() / count << "us, division: "
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() / count << "us" << std::endl;
+    }
+}
+
+// forwards to a context and counts the operations
+struct CountingContext {
+    const algo::math::BarrettContext &context;
+    mutable size_t muls = 0, sqrs = 0;
+
+    void mul(BigUint &r, const BigUint &a, const BigUint &b) const {
+        muls++;
+        context.mul(r, a, b);
+    }
+
+    void sqr(BigUint &r, const BigUint &a) const {
+        sqrs++;
+        context.sqr(r, a);
+    }
+};
+
+TEST(BigIntPowWindow, WINDOWS){
+    std::mt19937_64 rng(44);
+    for (size_t bits : {1, 2, 7, 8, 9, 30, 64, 100, 250, 700, 2048}) {
+        for (size_t k : {1, 4, 17}) {
+            BigUint mod = randomBigUint(rng, k), base = randomBigUint(rng, k + 1);
+            BigUint power = randomBigUint(rng, (bits + 63) / 64);
+            power.data.back() &= ~limb_t(0) >> (63 - (bits - 1) % 64);
+            power.set_bit(bits - 1);
+            mod.set_bit(0, k % 2 == 1);
+            const BigUint expected = powModByDivision(base, power, mod);
+            BigInt b = BigInt(base.to_string()), p = BigInt(power.to_string()), m = BigInt(mod.to_string());
+            algo::math::BarrettContext barrett(mod);
+            ASSERT_EQ(barrett.pow(base, power), expected);
+            ASSERT_EQ(barrett.powFixedWindow(base, power, bits + 5), expected);
+            ASSERT_EQ(algo::math::powMod(b, p, m).mag, expected);
+            ASSERT_EQ(algo::math::powMod(b, p, barrett).mag, expected);
+            ASSERT_EQ(algo::math::powModFixedWindow(b, p, m).mag, expected);
+            if (mod.test_bit(0)) {
+                algo::math::MontgomeryContext montgomery(mod);
+                ASSERT_EQ(montgomery.powFixedWindow(base, power, bits), expected);
+                ASSERT_EQ(algo::math::powMod(-b, p, montgomery), algo::math::powMod(-b, p, m));
+            }
+        }
+    }
+}
+
+TEST(BigIntPowWindow, BigIntPowWindowBenchmark){
+    std::mt19937_64 rng(45);
+    BigUint mod = randomBigUint(rng, 32), base = randomBigUint(rng, 32), power = randomBigUint(rng, 32);
+    mod.set_bit(0);
+    mod.set_bit(2047);
+    power.set_bit(2047);
+    algo::math::BarrettContext barrett(mod);
+    CountingContext counter{barrett};
+    BigUint res = algo::math::slidingWindowPow(counter, base % mod, power, 1);
+    size_t binary_muls = 0;
+    for (limb_t limb : power.data)
+        binary_muls += std::popcount(limb);
+    std::cout << "2048-bit exponent, sliding window: " << counter.muls << " multiplications and " << counter.sqrs
+              << " squarings, binary: " << binary_muls - 1 << " multiplications" << std::endl;
+    ASSERT_LT(counter.muls, binary_muls * 3 / 5);
+
+    algo::math::MontgomeryContext montgomery(mod);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    BigUint x = montgomery.pow(base, power);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    BigUint y = montgomery.powFixedWindow(base, power, 2048);
+    auto t3 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(x, res);
+    ASSERT_EQ(y, res);
+    std::cout << "2048-bit powMod, sliding window: " << std::chrono::duration<double, std::micro>(t2 - t1).count()
+              << "us, fixed window: " << std::chrono::duration<double, std::micro>(t3 - t2).count() << "us" << std::endl;
+}
+
+TEST(BigIntFixedBase, FIXED_BASE){
+    std::mt19937_64 rng(46);
+    for (size_t k : {1, 3, 8}) {
+        for (bool odd : {true, false}) {
+            BigUint mod = randomBigUint(rng, k);
+            mod.set_bit(0, odd);
+            const BigInt m = BigInt(mod.to_string()), g = -BigInt(randomBigUint(rng, k + 1).to_string());
+            for (size_t w : {1, 3, 4, 6}) {
+                algo::math::FixedBasePowMod pow_g(g, m, 300, w);
+                for (int it = 0; it < 10; it++) {
+                    BigInt power = BigInt(randomBigUint(rng, 1 + it % 5).to_string());
+                    ASSERT_EQ(pow_g(power), algo::math::powMod(g, power, m)) << k << " " << w << " " << power;
+                }
+                ASSERT_EQ(pow_g(0), 1);
+                ASSERT_EQ(pow_g(1), algo::math::normMod(g, m));
+                ASSERT_EQ(pow_g(BigInt(1) << 299), algo::math::powMod(g, BigInt(1) << 299, m));
+            }
+        }
+    }
+
+    // one table read from several threads
+    const BigInt p = algo::math::GenNextPrime(BigInt(1) << 256), g = 5;
+    algo::math::FixedBasePowMod pow_g(g, p, 256);
+    std::vector<BigInt> powers(64), results(64);
+    for (auto &power : powers)
+        power = BigInt(randomBigUint(rng, 4).to_string());
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    #pragma omp parallel for
+    for (int i = 0; i < 64; i++)
+        results[i] = pow_g(powers[i]);
+    omp_set_num_threads(threads);
+    for (int i = 0; i < 64; i++)
+        ASSERT_EQ(results[i], algo::math::powMod(g, powers[i], p));
+    ASSERT_THROW(algo::math::FixedBasePowMod(g, 0, 10), std::invalid_argument);
+}
+
+TEST(BigIntFixedBase, BigIntFixedBaseBenchmark){
+    std::mt19937_64 rng(47);
+    for (size_t k : {4, 32}) {
+        BigUint mod = randomBigUint(rng, k);
+        mod.set_bit(0);
+        mod.set_bit(k * BigUint::limb_bits - 1);
+        const BigInt m = BigInt(mod.to_string()), g = 2;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        algo::math::FixedBasePowMod pow_g(g, m, k * BigUint::limb_bits);
+        std::vector<BigInt> powers(20), x(20), y(20);
+        for (auto &power : powers)
+            power = BigInt(randomBigUint(rng, k).to_string());
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 20; i++)
+            x[i] = pow_g(powers[i]);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 20; i++)
+            y[i] = algo::math::powMod(g, powers[i], m);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(x, y);
+        std::cout << k * BigUint::limb_bits << "-bit fixed base, table: "
+                  << std::chrono::duration<double, std::micro>(t1 - t0).count() << "us, fixed base: "
+                  << std::chrono::duration<double, std::micro>(t2 - t1).count() / 20 << "us, powMod: "
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() / 20 << "us" << std::endl;
+    }
+}
+
+TEST(BigIntMultiPow, MULTI_POW){
+    std::mt19937_64 rng(48);
+    for (size_t k : {1, 3, 8}) {
+        for (bool odd : {true, false}) {
+            BigUint mod = randomBigUint(rng, k);
+            mod.set_bit(0, odd);
+            const BigInt m = BigInt(mod.to_string());
+            for (size_t terms : {0, 1, 2, 5, 31, 32, 70}) {
+                std::vector<BigInt> bases(terms), powers(terms);
+                BigInt expected = BigInt(1) % m;
+                for (size_t i = 0; i < terms; i++) {
+                    bases[i] = BigInt(randomBigUint(rng, k + 1).to_string());
+                    if (i % 3 == 1)
+                        bases[i] = -bases[i];
+                    powers[i] = BigInt(randomBigUint(rng, 1 + rng() % 4).to_string());
+                    if (i % 7 == 3)
+                        powers[i] = 0;
+                    expected = algo::math::mulMod(expected, algo::math::powMod(bases[i], powers[i], m), m);
+                }
+                ASSERT_EQ(algo::math::multiPowMod(bases, powers, m), expected) << k << " " << terms;
+                if (odd) {
+                    algo::math::MontgomeryContext context(mod);
+                    std::vector<BigUint> residues, exponents;
+                    for (size_t i = 0; i < terms; i++) {
+                        residues.push_back(context.toMontgomery(algo::math::normMod(bases[i], m).mag));
+                        exponents.push_back(powers[i].mag);
+                    }
+                    ASSERT_EQ(context.fromMontgomery(algo::math::pippengerPow(context, residues, exponents, context.one())),
+                              expected.mag);
+                    ASSERT_EQ(context.fromMontgomery(algo::math::strausPow(context, residues, exponents, context.one())),
+                              expected.mag);
+                }
+            }
+        }
+    }
+    ASSERT_THROW(algo::math::multiPowMod({1, 2}, {1}, 7), std::invalid_argument);
+}
+
+TEST(BigIntMultiPow, BigIntMultiPowBenchmark){
+    std::mt19937_64 rng(49);
+    BigUint mod = randomBigUint(rng, 32);
+    mod.set_bit(0);
+    mod.set_bit(2047);
+    algo::math::MontgomeryContext context(mod);
+    for (size_t terms : {2, 8, 128, 512, 2048}) {
+        std::vector<BigUint> residues, exponents;
+        for (size_t i = 0; i < terms; i++) {
+            residues.push_back(context.toMontgomery(randomBigUint(rng, 32)));
+            exponents.push_back(randomBigUint(rng, 4));
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        BigUint x = algo::math::strausPow(context, residues, exponents, context.one());
+        auto t2 = std::chrono::high_resolution_clock::now();
+        BigUint y = algo::math::pippengerPow(context, residues, exponents, context.one());
+        auto t3 = std::chrono::high_resolution_clock::now();
+        BigUint z = context.one();
+        for (size_t i = 0; i < std::min<size_t>(terms, 128); i++)
+            context.mul(z, z, context.toMontgomery(context.pow(context.fromMontgomery(residues[i]), exponents[i])));
+        auto t4 = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(x, y);
+        if (terms <= 128) {
+            ASSERT_EQ(x, z);
+        }
+        std::cout << terms << " powers with 256-bit exponents mod 2048 bits, Straus: "
+                  << std::chrono::duration<double, std::micro>(t2 - t1).count() << "us, Pippenger: "
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() << "us, separately: "
+                  << std::chrono::duration<double, std::micro>(t4 - t3).count() * terms / std::min<size_t>(terms, 128)
+                  << "us" << std::endl;
+    }
+}
+
+static BigUint gcdByDivision(BigUint a, BigUint b) {
+    while (!b.isZero()) {
+        a %= b;
+        std::swap(a, b);
+    }
+    return a;
+}
+
+// the recursive extended Euclid that lehmerGcdex replaced
+static BigInt gcdexByDivision(const BigInt &a, const BigInt &b, BigInt &x, BigInt &y) {
+    if (a == 0) {
+        x = 0;
+        y = 1;
+        return b;
+    }
+    BigInt q, r, x1, y1;
+    divrem(b, a, q, r);
+    BigInt d = gcdexByDivision(r, a, x1, y1);
+    x = y1 - q * x1;
+    y = x1;
+    return d;
+}
+
+TEST(BigIntGcd, GCD){
+    std::mt19937_64 rng(50);
+    for (size_t k : {1, 2, 3, 5, 12, 40}) {
+        for (int iter = 0; iter < 20; iter++) {
+            BigUint common = randomBigUint(rng, 1 + rng() % 2) >> (rng() % 100);
+            BigUint a = randomBigUint(rng, k) * common, b = randomBigUint(rng, 1 + rng() % (k + 1)) * common;
+            if (iter % 5 == 0)
+                b >>= rng() % (b.bit_length() + 1);
+            const BigUint g = gcdByDivision(a, b);
+            ASSERT_EQ(algo::math::lehmerGcd(a, b), g) << a << " " << b;
+            ASSERT_EQ(algo::math::lehmerGcd(b, a), g);
+
+            BigInt x;
+            ASSERT_EQ(algo::math::lehmerGcdex(a, b, x), g);
+            if (!b.isZero()) {
+                ASSERT_LE(x.mag, b);
+                ASSERT_EQ(algo::math::normMod(BigInt(a.to_string()) * x, BigInt(b.to_string())).mag, g % b);
+            }
+
+            const BigInt sa = (iter % 2 ? -BigInt(a.to_string()) : BigInt(a.to_string()));
+            const BigInt sb = (iter % 3 ? BigInt(b.to_string()) : -BigInt(b.to_string()));
+            BigInt y;
+            const BigInt d = algo::math::gcdex(sa, sb, x, y);
+            ASSERT_EQ(d.mag, g);
+            ASSERT_EQ(sa * x + sb * y, d);
+            ASSERT_EQ(algo::math::gcd(sa, sb), d);
+        }
+    }
+    BigInt x, y;
+    ASSERT_EQ(algo::math::gcdex(0, 0, x, y), 0);
+    ASSERT_EQ(algo::math::gcdex(0, -5, x, y), 5);
+    ASSERT_EQ(-5 * y, 5);
+    ASSERT_EQ(algo::math::inverseMod(-3, 7), 2);
+    ASSERT_EQ(algo::math::inverseMod(10, 1), 0);
+    ASSERT_THROW(algo::math::inverseMod(6, 9), std::invalid_argument);
+}
+
+TEST(BigIntGcd, BigIntGcdBenchmark){
+    std::mt19937_64 rng(51);
+    for (size_t k : {4, 16, 32, 64}) {
+        BigUint mod = randomBigUint(rng, k);
+        mod.set_bit(0);
+        const BigInt m = BigInt(mod.to_string());
+        BigInt a = BigInt(randomBigUint(rng, k).to_string()) % m;
+        while (algo::math::gcd(a, m) != 1)
+            a += 1;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        BigInt inverse = algo::math::inverseMod(a, m);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        BigInt x, y, d = gcdexByDivision(a, m, x, y);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        BigUint g = algo::math::lehmerGcd(a.mag, mod);
+        auto t4 = std::chrono::high_resolution_clock::now();
+        BigUint h = gcdByDivision(a.mag, mod);
+        auto t5 = std::chrono::high_resolution_clock::now();
+        ASSERT_EQ(g, h);
+        ASSERT_EQ(d, 1);
+        ASSERT_EQ(inverse, algo::math::normMod(x, m));
+        std::cout << k * 64 << " bits, inverse Lehmer: "
+                  << std::chrono::duration<double, std::micro>(t2 - t1).count() << "us, recursive Euclid: "
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() << "us, gcd Lehmer: "
+                  << std::chrono::duration<double, std::micro>(t4 - t3).count() << "us, Euclid: "
+                  << std::chrono::duration<double, std::micro>(t5 - t4).count() << "us" << std::endl;
+    }
+}
+
+TEST(BigIntBatchInverse, BATCH_INVERSE){
+    std::mt19937_64 rng(52);
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    for (size_t k : {1, 4}) {
+        BigUint mod = randomBigUint(rng, k);
+        mod.set_bit(0, k > 1);
+        const BigInt m = BigInt(mod.to_string());
+        for (size_t n : {0, 1, 2, 7, 255, 256, 300}) {
+            std::vector<BigInt> nums;
+            while (nums.size() < n) {
+                BigInt x = BigInt(randomBigUint(rng, k + 1).to_string());
+                if (nums.size() % 3 == 1)
+                    x = -x;
+                if (algo::math::gcd(x, m) == 1)
+                    nums.push_back(x);
+            }
+            std::vector<BigInt> inverses = nums;
+            algo::math::batchInverseMod(inverses, m);
+            for (size_t i = 0; i < n; i++)
+                ASSERT_EQ(inverses[i], algo::math::inverseMod(nums[i], m)) << k << " " << n << " " << i;
+
+            if (n > 1) {
+                std::vector<BigInt> bad = nums;
+                bad[n / 2] = m * 3;
+                ASSERT_THROW(algo::math::batchInverseMod(bad, m), std::invalid_argument);
+                ASSERT_EQ(bad[0], nums[0]);
+            }
+        }
+    }
+    omp_set_num_threads(threads);
+    std::vector<BigInt> nums = {3, 5};
+    ASSERT_THROW(algo::math::batchInverseMod(nums, 0), std::invalid_argument);
+    algo::math::batchInverseMod(nums, 1);
+    ASSERT_EQ(nums, std::vector<BigInt>({0, 0}));
+}
+
+TEST(BigIntBatchInverse, BigIntBatchInverseBenchmark){
+    std::mt19937_64 rng(53);
+    const int threads = omp_get_max_threads();
+    for (size_t k : {4, 32}) {
+        BigUint mod = randomBigUint(rng, k);
+        mod.set_bit(0);
+        mod.set_bit(k * BigUint::limb_bits - 1);
+        const BigInt m = BigInt(mod.to_string());
+        std::vector<BigInt> nums;
+        while (nums.size() < 1000) {
+            BigInt x = BigInt(randomBigUint(rng, k).to_string()) % m;
+            if (algo::math::gcd(x, m) == 1)
+                nums.push_back(x);
+        }
+        std::vector<BigInt> chain = nums, tree = nums, single(nums.size());
+        omp_set_num_threads(1);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        algo::math::batchInverseMod(chain, m);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        omp_set_num_threads(4);
+        algo::math::batchInverseMod(tree, m);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < nums.size(); i++)
+            single[i] = algo::math::inverseMod(nums[i], m);
+        auto t4 = std::chrono::high_resolution_clock::now();
+        omp_set_num_threads(threads);
+        ASSERT_EQ(chain, single);
+        ASSERT_EQ(tree, single);
+        std::cout << "1000 inverses mod " << k * 64 << " bits, batch: "
+                  << std::chrono::duration<double, std::micro>(t2 - t1).count() << "us, tree with 4 threads: "
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() << "us, one by one: "
+                  << std::chrono::duration<double, std::micro>(t4 - t3).count() << "us" << std::endl;
+    }
+}
+
+// Garner's algorithm as chineese did it before CrtBasis: O(n^2) multiplications
+static BigInt chineeseGarner(const std::vector<BigInt> &residues, const std::vector<BigInt> &moduli) {
+    const size_t n = moduli.size();
+    std::vector<BigInt> x(n);
+    BigInt res, coef = 1;
+    for (size_t i = 0; i < n; i++) {
+        std::vector<BigInt> inverses(moduli.begin(), moduli.begin() + i);
+        algo::math::batchInverseMod(inverses, moduli[i]);
+        algo::math::BarrettContext reducer(moduli[i].mag);
+        x[i] = algo::math::normMod(residues[i], reducer);
+        for (size_t j = 0; j < i; j++) {
+            x[i] -= x[j];
+            x[i] *= inverses[j];
+            x[i] = algo::math::normMod(std::move(x[i]), reducer);
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        res += x[i] * coef;
+        coef *= moduli[i];
+    }
+    return res;
+}
+
+// n pairwise coprime moduli of up to `limbs` limbs and random residues, some negative
+static void randomCrtSystem(std::mt19937_64 &rng, size_t n, size_t limbs, std::vector<BigInt> &residues,
+                            std::vector<BigInt> &moduli) {
+    BigInt product = 1;
+    residues.clear();
+    moduli.clear();
+    while (moduli.size() < n) {
+        BigInt m = BigInt(randomBigUint(rng, 1 + rng() % limbs).to_string());
+        if (m <= 1 || algo::math::gcd(m, product) != 1)
+            continue;
+        product *= m;
+        moduli.push_back(m);
+        residues.push_back(BigInt(randomBigUint(rng, limbs + 1).to_string()));
+        if (moduli.size() % 4 == 0)
+            residues.back() = -residues.back();
+    }
+}
+
+TEST(BigIntCrt, CRT){
+    std::mt19937_64 rng(54);
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    std::vector<BigInt> residues, moduli;
+    for (size_t n : {1, 2, 3, 7, 64, 100}) {
+        for (size_t limbs : {1, 3}) {
+            randomCrtSystem(rng, n, limbs, residues, moduli);
+            algo::math::CrtBasis basis(moduli);
+            BigInt x = basis.reconstruct(residues);
+            ASSERT_GE(x, 0);
+            ASSERT_LT(x.mag, basis.product());
+            for (size_t i = 0; i < n; i++)
+                ASSERT_EQ(algo::math::normMod(x - residues[i], moduli[i]), 0) << n << " " << i;
+            BigInt product;
+            product.mag = basis.product();
+            ASSERT_EQ(x, algo::math::normMod(chineeseGarner(residues, moduli), product));
+            ASSERT_EQ(basis.reconstruct(std::vector<BigInt>(n, 1)), 1);
+        }
+    }
+    omp_set_num_threads(threads);
+
+    ASSERT_EQ(algo::math::chineese({}), 0);
+    ASSERT_EQ(algo::math::chineese({{5, 1}, {-1, 4}}), 3);
+    ASSERT_THROW(algo::math::CrtBasis({6, 35, 10}), std::invalid_argument);
+    ASSERT_THROW(algo::math::CrtBasis({6, 0}), std::invalid_argument);
+    ASSERT_THROW(algo::math::CrtBasis({3, 5}).reconstruct({1}), std::invalid_argument);
+}
+
+TEST(BigIntCrt, BigIntCrtBenchmark){
+    std::mt19937_64 rng(55);
+    std::vector<BigInt> residues, moduli;
+    for (size_t n : {100, 1000, 4000}) {
+        randomCrtSystem(rng, n, 1, residues, moduli);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        algo::math::CrtBasis basis(moduli);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        BigInt x = basis.reconstruct(residues);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        std::cout << n << " 64-bit moduli, basis: " << std::chrono::duration<double, std::milli>(t2 - t1).count()
+                  << "ms, reconstruction: " << std::chrono::duration<double, std::milli>(t3 - t2).count() << "ms";
+        if (n <= 1000) {
+            BigInt y = chineeseGarner(residues, moduli);
+            auto t4 = std::chrono::high_resolution_clock::now();
+            ASSERT_EQ(x, y);
+            std::cout << ", Garner: " << std::chrono::duration<double, std::milli>(t4 - t3).count() << "ms";
+        }
+        std::cout << std::endl;
+    }
+}
+
+TEST(BigIntPrimality, BigIntPrimalityBenchmark){
+    std::mt19937_64 rng(56);
+    for (size_t k : {4, 16, 32}) {
+        const size_t count = 200;
+        std::vector<BigInt> nums;
+        for (size_t i = 0; i < count; i++) {
+            BigUint x = randomBigUint(rng, k);
+            x.set_bit(0);
+            x.set_bit(k * BigUint::limb_bits - 1);
+            nums.push_back(BigInt(x.to_string()));
+        }
+        size_t primes = 0, trial = 0;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (const BigInt &x : nums)
+            primes += algo::math::isPrime(x);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        for (const BigInt &x : nums)
+            trial += algo::math::hasSmallFactor(x.mag);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        const BigInt prime = algo::math::GenNextPrime(nums[0]);
+        auto t4 = std::chrono::high_resolution_clock::now();
+        ASSERT_TRUE(algo::math::isPrime(prime));
+        auto t5 = std::chrono::high_resolution_clock::now();
+        ASSERT_FALSE(algo::math::isPrimeMillerRabin(prime * prime, 1));
+        std::cout << k * 64 << "-bit odd numbers: " << primes << " of " << count << " prime, "
+                  << trial << " with a factor below 1000, isPrime: "
+                  << std::chrono::duration<double, std::micro>(t2 - t1).count() / count << "us per number, trial division: "
+                  << std::chrono::duration<double, std::micro>(t3 - t2).count() / count << "us, next prime: "
+                  << std::chrono::duration<double, std::milli>(t4 - t3).count() << "ms, one prime: "
+                  << std::chrono::duration<double, std::micro>(t5 - t4).count() << "us" << std::endl;
+    }
+}
 
 /*
 TEST(BigIntPow, POW_1){
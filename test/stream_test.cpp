@@ -5,6 +5,7 @@
 #include <chrono>
 #include <iostream>
 #include <StreamCiphers/Aes.h>
+#include <StreamCiphers/Cipher.h>
 
 #include "gtest/gtest.h"
 #include "utils.h"
@@ -92,8 +93,86 @@ TEST(StreamCiphersTest, Rc4Test) {
     ASSERT_EQ(text, decrypted);
 }
 
+TEST(StreamCiphersTest, Rc4ContextTest) {
+    const std::vector<uint8_t> key = ToVec("secret rc4 key");
+    const std::vector<uint8_t> text = ToVec("RC4 (Rivest Cipher 4 also known as ARC4 or ARCFOUR meaning Alleged RC4)");
+
+    std::vector<uint8_t> expected(text.size());
+    rc4::apply(text.data(), text.size(), key.data(), key.size(), expected.data());
+
+    // keystream continues across calls
+    std::vector<uint8_t> encrypted(text.size());
+    rc4::Context context(key.data(), key.size());
+    const size_t split = 17;
+    context.Apply(text.data(), split, encrypted.data());
+    context.Apply(text.data() + split, text.size() - split, encrypted.data() + split);
+    ASSERT_EQ(expected, encrypted);
+
+    // drop-N skips first N bytes of keystream
+    rc4::Context dropped(key.data(), key.size(), split);
+    std::vector<uint8_t> tail(text.size() - split);
+    dropped.Apply(text.data() + split, tail.size(), tail.data());
+    ASSERT_EQ(std::vector<uint8_t>(expected.begin() + split, expected.end()), tail);
+}
+
+TEST(StreamCiphersTest, Rc4BatchTest) {
+    constexpr size_t kStreams = 13;
+    std::vector<std::vector<uint8_t>> keys, texts, outs, expected;
+    std::vector<rc4::Context> contexts;
+    for(size_t k = 0; k < kStreams; k++) {
+        keys.push_back(GenerateRandomVec(5 + k));
+        texts.push_back(GenerateRandomVec(1000 + 37 * k));
+        outs.emplace_back(texts.back().size());
+        expected.emplace_back(texts.back().size());
+        rc4::apply(texts[k].data(), texts[k].size(), keys[k].data(), keys[k].size(), expected[k].data());
+        contexts.emplace_back(keys[k].data(), keys[k].size());
+    }
+
+    std::vector<const uint8_t*> text_ptrs;
+    std::vector<uint8_t*> out_ptrs;
+    std::vector<size_t> lens;
+    for(size_t k = 0; k < kStreams; k++) {
+        text_ptrs.push_back(texts[k].data());
+        out_ptrs.push_back(outs[k].data());
+        lens.push_back(texts[k].size());
+    }
+    rc4::apply_batch(contexts.data(), text_ptrs.data(), out_ptrs.data(), lens.data(), kStreams);
+    ASSERT_EQ(expected, outs);
+}
+
+TEST(StreamCiphersTest, Rc4BatchBenchmark) {
+    constexpr size_t kStreams = 64;
+    constexpr size_t kSize = 1 << 16;
+    const auto key = ToVec("secret rc4 key");
+    std::vector<std::vector<uint8_t>> texts(kStreams, std::vector<uint8_t>(kSize, 0x5a));
+    std::vector<std::vector<uint8_t>> sequential_outs = texts, batched_outs = texts;
+    std::vector<const uint8_t*> text_ptrs;
+    std::vector<uint8_t*> sequential_ptrs, batched_ptrs;
+    std::vector<size_t> lens(kStreams, kSize);
+    for(size_t k = 0; k < kStreams; k++) {
+        text_ptrs.push_back(texts[k].data());
+        sequential_ptrs.push_back(sequential_outs[k].data());
+        batched_ptrs.push_back(batched_outs[k].data());
+    }
+
+    std::vector<rc4::Context> sequential(kStreams, rc4::Context(key.data(), key.size()));
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for(size_t k = 0; k < kStreams; k++) {
+        sequential[k].Apply(text_ptrs[k], kSize, sequential_ptrs[k]);
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::vector<rc4::Context> batched(kStreams, rc4::Context(key.data(), key.size()));
+    rc4::apply_batch(batched.data(), text_ptrs.data(), batched_ptrs.data(), lens.data(), kStreams);
+    auto t3 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(sequential_outs, batched_outs);
+
+    std::cout << "RC4, streams: " << kStreams << ", size: " << (double)(kStreams * kSize)
+              << ", sequential: " << std::chrono::duration<double>(t2 - t1).count() << "s"
+              << ", batched: " << std::chrono::duration<double>(t3 - t2).count() << "s" << std::endl;
+}
+
 TEST(StreamCiphersTest, Salsa20Test) {
-    const std::vector<uint8_t> key = ToVec("secret salsa key");
+    const std::vector<uint8_t> key = ToVec("secret salsa key, 32 bytes long!");
     const uint64_t nonce = 0x12979712;
     const std::vector<uint8_t> text = ToVec("Salsa20 and the closely related ChaCha are stream ciphers developed by Daniel J. Bernstein");
 
@@ -110,6 +189,105 @@ TEST(StreamCiphersTest, Salsa20Test) {
     std::cout << std::setw(20) << "Decrypted text: " << ToStr(decrypted) << std::endl;
 
     ASSERT_EQ(text, decrypted);
+
+    // all 32 key bytes take part, up to the last one
+    auto other_key = key;
+    other_key.back() ^= 1;
+    std::vector<uint8_t> other(text.size());
+    salsa20::apply(text.data(), text.size(), other_key.data(), nonce, other.data());
+    ASSERT_NE(encrypted, other);
 }
 
-}
\ No newline at end of file
+class CipherRegistryTest : public testing::TestWithParam<std::string> {};
+INSTANTIATE_TEST_SUITE_P(AllCiphers, CipherRegistryTest, testing::ValuesIn(CipherRegistry::Instance().GetNames()),
+                         [](const auto &info) {
+                             auto name = info.param;
+                             std::replace(name.begin(), name.end(), '-', '_');
+                             return name;
+                         });
+
+TEST_P(CipherRegistryTest, EncryptDecrypt) {
+    auto &registry = CipherRegistry::Instance();
+    const auto key = GenerateRandomVec(registry.GetKeySize(GetParam()) ? registry.GetKeySize(GetParam()) : 16);
+    auto cipher = registry.Create(GetParam(), key);
+
+    const std::vector<uint8_t> input = GenerateRandomVec(1024);
+    auto data = input;
+    cipher->Encrypt(data);
+    ASSERT_NE(input, data);
+    cipher->Decrypt(data);
+    ASSERT_EQ(input, data);
+}
+
+TEST_P(CipherRegistryTest, Benchmark) {
+    auto &registry = CipherRegistry::Instance();
+    const auto key = GenerateRandomVec(registry.GetKeySize(GetParam()) ? registry.GetKeySize(GetParam()) : 16);
+    auto cipher = registry.Create(GetParam(), key);
+
+    const size_t size = 1'000'000;
+    std::cout << GetParam() << ", size: " << (double)size << ", time: " << BenchmarkCipher(*cipher, size) << "s" << std::endl;
+}
+
+TEST(CipherRegistryTest, Rc4NonceChangesKeystream) {
+    auto rc4 = CipherRegistry::Instance().Create("rc4", ToVec("secret rc4 key"));
+    const std::vector<uint8_t> input(64, 0);
+    auto first = input, second = input;
+    rc4->Encrypt(first);
+    rc4->Encrypt(second);
+    // with a zero plain text the cipher text is the nonce followed by the keystream
+    ASSERT_NE(std::vector<uint8_t>(first.begin() + Rc4Cipher::kNonceSize, first.end()),
+              std::vector<uint8_t>(second.begin() + Rc4Cipher::kNonceSize, second.end()));
+    rc4->Decrypt(second);
+    ASSERT_EQ(input, second);
+}
+
+TEST(CipherRegistryTest, InvalidInput) {
+    auto &registry = CipherRegistry::Instance();
+    ASSERT_THROW(registry.Create("aes-128-ctr", GenerateRandomVec(24)), std::logic_error);
+    ASSERT_THROW(registry.Create("unknown", GenerateRandomVec(16)), std::invalid_argument);
+
+    // ECB does not pad, a trailing partial block is rejected instead of left in plain text
+    auto ecb = registry.Create("aes-128-ecb", GenerateRandomVec(16));
+    auto data = GenerateRandomVec(40);
+    ASSERT_THROW(ecb->Encrypt(data), std::invalid_argument);
+    ASSERT_THROW(ecb->Decrypt(data), std::invalid_argument);
+
+    for(const auto &name : registry.GetNames()) {
+        if(name.rfind("aes-", 0) != 0) {
+            continue;
+        }
+        auto cipher = registry.Create(name, GenerateRandomVec(registry.GetKeySize(name)));
+        const bool ecb = name.ends_with("-ecb");
+        for(size_t size : {0, 8, 40}) {
+            const auto input = GenerateRandomVec(size);
+            auto data = input;
+            if(ecb && size % 16 != 0) {
+                ASSERT_THROW(cipher->Encrypt(data), std::invalid_argument) << name << " " << size;
+                continue;
+            }
+            cipher->Encrypt(data);
+            cipher->Decrypt(data);
+            ASSERT_EQ(input, data) << name << " " << size;
+        }
+        if(!ecb) {
+            // shorter than IV plus one block, or not whole blocks
+            for(size_t size : {0, 8, 16, 40}) {
+                auto data = GenerateRandomVec(size);
+                ASSERT_THROW(cipher->Decrypt(data), std::invalid_argument) << name << " " << size;
+            }
+        }
+    }
+
+    ASSERT_THROW(registry.Create("rc4", {}), std::logic_error);
+    ASSERT_THROW(registry.Create("rc4", GenerateRandomVec(256)), std::logic_error);
+    auto rc4 = registry.Create("rc4", GenerateRandomVec(16));
+    auto short_rc4 = GenerateRandomVec(Rc4Cipher::kNonceSize - 1);
+    ASSERT_THROW(rc4->Decrypt(short_rc4), std::invalid_argument);
+
+    auto salsa = registry.Create("salsa20", GenerateRandomVec(32));
+    auto truncated = GenerateRandomVec(Salsa20Cipher::kNonceSize - 1);
+    ASSERT_THROW(salsa->Decrypt(truncated), std::invalid_argument);
+    ASSERT_THROW(Salsa20Cipher(GenerateRandomVec(16)), std::logic_error);
+}
+
+}